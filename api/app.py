@@ -9,8 +9,11 @@ This module provides an HTTP server that:
 
 from flask import Flask, request, jsonify
 from flask_cors import CORS
+import hashlib
 import os
 import sys
+import threading
+from collections import OrderedDict
 
 # Add parent directory to path to import config and utils
 sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
@@ -37,6 +40,54 @@ CORS(app, resources={r"/*": cors_config})
 compiler = CompilerInvoker(Config.COMPILER_PATH)
 
 
+# ============================================================================
+# Compile result cache
+# ============================================================================
+# Classroom traffic submits the same canonical sources thousands of times a
+# day; the full tokens/AST/asm payload is deterministic for a given
+# (source, options) pair, so cache it keyed by content hash with an LRU
+# bound. Hits never touch mycc at all. Misses go through CompilerInvoker,
+# which already prefers a pre-warmed daemon connection (MYCC_DAEMON_SOCKET)
+# over spawning a process.
+class CompileResultCache:
+    def __init__(self, max_entries):
+        self._entries = OrderedDict()
+        self._lock = threading.Lock()
+        self._max_entries = max_entries
+        self.hits = 0
+        self.misses = 0
+
+    @staticmethod
+    def key_for(source_code, options=""):
+        digest = hashlib.sha256()
+        digest.update(source_code.encode("utf-8"))
+        digest.update(b"\x00")
+        digest.update(options.encode("utf-8"))
+        return digest.hexdigest()
+
+    def get(self, key):
+        with self._lock:
+            result = self._entries.get(key)
+            if result is not None:
+                self._entries.move_to_end(key)  # LRU touch
+                self.hits += 1
+            else:
+                self.misses += 1
+            return result
+
+    def put(self, key, result):
+        with self._lock:
+            self._entries[key] = result
+            self._entries.move_to_end(key)
+            while len(self._entries) > self._max_entries:
+                self._entries.popitem(last=False)  # Evict least recent
+
+
+compile_cache = CompileResultCache(
+    max_entries=int(os.environ.get("MYCC_COMPILE_CACHE_SIZE", "256"))
+)
+
+
 @app.route("/health", methods=["GET"])
 def health_check():
     """Health check endpoint to verify API is running."""
@@ -130,8 +181,18 @@ def compile_code():
                 400,
             )
 
-        # Invoke compiler with default filename
-        result = compiler.compile(source_code, filename="input.c")
+        # Serve repeated submissions straight from the cache
+        cache_key = CompileResultCache.key_for(source_code)
+        result = compile_cache.get(cache_key)
+        if result is None:
+            # Invoke compiler with default filename
+            result = compiler.compile(source_code, filename="input.c")
+            # Only deterministic outcomes (success or a real compile error)
+            # belong in the cache. Timeouts and invoker failures are
+            # transient (return_code == -1): caching one would pin a 408
+            # onto this source forever instead of retrying the compiler.
+            if result.get("return_code") != -1:
+                compile_cache.put(cache_key, result)
 
         # Check for timeout specifically
         if (
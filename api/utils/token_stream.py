@@ -0,0 +1,84 @@
+"""Decoder for mycc's binary token-stream dump (MTK1 format).
+
+The compiler's --dump-tokens-bin output is a compact fixed-width record
+stream with one interned string table; for large files it is a fraction
+of the JSON payload's size and decodes with a single struct pass instead
+of a JSON parse. decode() returns the same shape as the JSON dump so the
+rest of the API and the frontend are agnostic to which format was used.
+
+Layout (all integers little-endian uint32):
+    magic b"MTK1"
+    token_count
+    type_name_count
+    string_table_size
+    type_name_count * (name_offset, name_length)
+    token_count * (type, value_off, value_len,
+                   processed_off, processed_len,    # (0,0) = no processed
+                   file_off, file_len, line, column)
+    string table bytes
+"""
+
+import struct
+from typing import Any, Dict
+
+MAGIC = b"MTK1"
+HEADER = struct.Struct("<4sIII")
+NAME_ENTRY = struct.Struct("<II")
+RECORD = struct.Struct("<IIIIIIIII")
+
+
+def decode(data: bytes) -> Dict[str, Any]:
+    """Decode an MTK1 buffer into the JSON-dump dictionary shape."""
+    magic, token_count, type_name_count, table_size = HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        raise ValueError("not an MTK1 token stream")
+
+    names_offset = HEADER.size
+    records_offset = names_offset + type_name_count * NAME_ENTRY.size
+    table_offset = records_offset + token_count * RECORD.size
+    table = data[table_offset : table_offset + table_size]
+
+    def table_str(offset: int, length: int) -> str:
+        return table[offset : offset + length].decode("utf-8", errors="replace")
+
+    type_names = []
+    for i in range(type_name_count):
+        off, length = NAME_ENTRY.unpack_from(data, names_offset + i * NAME_ENTRY.size)
+        type_names.append(table_str(off, length))
+
+    tokens = []
+    for i in range(token_count):
+        (
+            type_id,
+            value_off,
+            value_len,
+            processed_off,
+            processed_len,
+            file_off,
+            file_len,
+            line,
+            column,
+        ) = RECORD.unpack_from(data, records_offset + i * RECORD.size)
+        token = {
+            "type": type_names[type_id] if type_id < type_name_count else "UNKNOWN",
+            "value": table_str(value_off, value_len),
+            "location": {
+                "file": table_str(file_off, file_len),
+                "line": line,
+                "column": column,
+            },
+        }
+        if processed_len or processed_off:
+            token["processed_value"] = table_str(processed_off, processed_len)
+        tokens.append(token)
+
+    return {
+        "stage": "lexical_analysis",
+        "token_count": token_count,
+        "tokens": tokens,
+    }
+
+
+def decode_file(path: str) -> Dict[str, Any]:
+    with open(path, "rb") as handle:
+        return decode(handle.read())
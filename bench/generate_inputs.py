@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+"""Generate synthetic C inputs of controlled shape for the compile-speed
+benchmark suite.
+
+Shapes:
+  many_small   - thousands of tiny functions (stresses per-function overhead)
+  one_huge     - a single function with a very long straight-line body
+                 (stresses per-instruction costs and register allocation)
+  deep_exprs   - deeply nested arithmetic expressions (stresses the
+                 recursive-descent parser and IR expression lowering)
+  struct_heavy - many struct definitions and member accesses (stresses the
+                 semantic phase's type machinery)
+
+Outputs land in bench/inputs/. Sizes are chosen so a full run takes
+seconds, not minutes; pass --scale to grow them.
+"""
+
+import argparse
+import os
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+INPUT_DIR = os.path.join(HERE, "inputs")
+
+
+def many_small(scale):
+    parts = []
+    for i in range(800 * scale):
+        parts.append(
+            f"int f{i}(int a, int b) {{ int t = a * {i % 7 + 1}; return t + b; }}"
+        )
+    parts.append("int main(void) { return f0(1, 2); }")
+    return "\n".join(parts)
+
+
+def one_huge(scale):
+    lines = ["int main(void) {", "  int acc = 0;"]
+    for i in range(4000 * scale):
+        lines.append(f"  int v{i} = acc * 3 + {i % 100};")
+        lines.append(f"  acc = acc + v{i};")
+    lines.append("  return acc;")
+    lines.append("}")
+    return "\n".join(lines)
+
+
+def deep_exprs(scale):
+    lines = ["int main(void) {", "  int x = 1;"]
+    for i in range(200 * scale):
+        expr = "x"
+        for j in range(40):
+            expr = f"({expr} + {j}) * 2 - x"
+        lines.append(f"  int d{i} = {expr};")
+    lines.append("  return x;")
+    lines.append("}")
+    return "\n".join(lines)
+
+
+def struct_heavy(scale):
+    parts = []
+    for i in range(300 * scale):
+        parts.append(
+            f"struct S{i} {{ int a; int b; int c; int d; }};"
+        )
+    parts.append("int main(void) {")
+    for i in range(0, 300 * scale, 10):
+        parts.append(f"  struct S{i} s{i};")
+        parts.append(f"  s{i}.a = {i};")
+        parts.append(f"  s{i}.b = s{i}.a + 1;")
+    parts.append("  return 0;")
+    parts.append("}")
+    return "\n".join(parts)
+
+
+GENERATORS = {
+    "many_small": many_small,
+    "one_huge": one_huge,
+    "deep_exprs": deep_exprs,
+    "struct_heavy": struct_heavy,
+}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--scale", type=int, default=1,
+                        help="size multiplier for all shapes (default 1)")
+    args = parser.parse_args()
+
+    os.makedirs(INPUT_DIR, exist_ok=True)
+    for name, generator in GENERATORS.items():
+        path = os.path.join(INPUT_DIR, name + ".c")
+        source = generator(args.scale)
+        with open(path, "w") as handle:
+            handle.write(source)
+        print(f"  {name}.c: {len(source)} bytes, "
+              f"{source.count(chr(10)) + 1} lines")
+
+
+if __name__ == "__main__":
+    main()
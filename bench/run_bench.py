@@ -0,0 +1,162 @@
+#!/usr/bin/env python3
+"""Compile-speed benchmark runner for mycc.
+
+For every input in bench/inputs/ this times `bin/mycc -S` (front half of
+the pipeline through codegen; no assembler/linker noise) with warmup and
+repetitions, reports tokens/sec, lines/sec and wall milliseconds, and
+compares against bench/baseline.json when present. A stage-level
+breakdown comes from --dump-opt-stats (per-pass optimizer timing) and,
+when the compiler supports it, --dump-timing.
+
+Usage:
+  python3 bench/run_bench.py                 # run and compare to baseline
+  python3 bench/run_bench.py --update-baseline
+  python3 bench/run_bench.py --reps 9
+"""
+
+import argparse
+import json
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+REPO = os.path.dirname(HERE)
+COMPILER = os.path.join(REPO, "bin", "mycc")
+INPUT_DIR = os.path.join(HERE, "inputs")
+BASELINE_PATH = os.path.join(HERE, "baseline.json")
+
+# Regression tolerance: a benchmark this much slower than baseline fails.
+# SLACK_MS absorbs scheduler noise on benchmarks that run in milliseconds.
+TOLERANCE = 1.25
+SLACK_MS = 20.0
+
+
+def count_tokens(source_path, tmpdir):
+    tokens_path = os.path.join(tmpdir, "tokens.json")
+    out_path = os.path.join(tmpdir, "out.s")
+    subprocess.run(
+        [COMPILER, "--dump-tokens", tokens_path, "-S", "-o", out_path,
+         source_path],
+        capture_output=True,
+    )
+    try:
+        with open(tokens_path) as handle:
+            dump = json.load(handle)
+        if isinstance(dump, dict) and "token_count" in dump:
+            return dump["token_count"]
+        if isinstance(dump, dict) and "tokens" in dump:
+            return len(dump["tokens"])
+        return len(dump)
+    except (OSError, ValueError):
+        return 0
+
+
+def time_compile(source_path, tmpdir, reps, warmup):
+    out_path = os.path.join(tmpdir, "out.s")
+    cmd = [COMPILER, "-S", "-o", out_path, source_path]
+    for _ in range(warmup):
+        subprocess.run(cmd, capture_output=True)
+    samples = []
+    for _ in range(reps):
+        start = time.perf_counter()
+        result = subprocess.run(cmd, capture_output=True)
+        samples.append(time.perf_counter() - start)
+        if result.returncode != 0:
+            print(f"  ERROR: compile failed for {source_path}")
+            print(result.stderr.decode(errors="replace")[:500])
+            return None
+    return samples
+
+
+def opt_pass_breakdown(source_path, tmpdir):
+    stats_path = os.path.join(tmpdir, "opt.json")
+    out_path = os.path.join(tmpdir, "out.s")
+    subprocess.run(
+        [COMPILER, "--dump-opt-stats", stats_path, "-S", "-o", out_path,
+         source_path],
+        capture_output=True,
+    )
+    try:
+        with open(stats_path) as handle:
+            return {entry["pass"]: entry["wall_time_us"] / 1000.0
+                    for entry in json.load(handle)}
+    except (OSError, ValueError):
+        return {}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--reps", type=int, default=5)
+    parser.add_argument("--warmup", type=int, default=1)
+    parser.add_argument("--update-baseline", action="store_true")
+    args = parser.parse_args()
+
+    if not os.path.exists(COMPILER):
+        sys.exit(f"error: {COMPILER} not built (run `make` first)")
+    if not os.path.isdir(INPUT_DIR) or not os.listdir(INPUT_DIR):
+        sys.exit("error: no inputs (run bench/generate_inputs.py first)")
+
+    baseline = {}
+    if os.path.exists(BASELINE_PATH):
+        with open(BASELINE_PATH) as handle:
+            baseline = json.load(handle)
+
+    results = {}
+    failed = False
+
+    for name in sorted(os.listdir(INPUT_DIR)):
+        if not name.endswith(".c"):
+            continue
+        source_path = os.path.join(INPUT_DIR, name)
+        with open(source_path) as handle:
+            source = handle.read()
+        lines = source.count("\n") + 1
+
+        with tempfile.TemporaryDirectory() as tmpdir:
+            samples = time_compile(source_path, tmpdir, args.reps, args.warmup)
+            if samples is None:
+                failed = True
+                continue
+            tokens = count_tokens(source_path, tmpdir)
+            passes = opt_pass_breakdown(source_path, tmpdir)
+
+        median_s = statistics.median(samples)
+        results[name] = {"median_ms": round(median_s * 1000.0, 2)}
+
+        print(f"{name}:")
+        print(f"  median      {median_s * 1000.0:9.2f} ms "
+              f"(min {min(samples) * 1000.0:.2f}, "
+              f"max {max(samples) * 1000.0:.2f}, n={args.reps})")
+        print(f"  throughput  {tokens / median_s:12,.0f} tokens/sec, "
+              f"{lines / median_s:10,.0f} lines/sec")
+        if passes:
+            breakdown = ", ".join(f"{k} {v:.2f}ms" for k, v in passes.items())
+            print(f"  opt passes  {breakdown}")
+
+        if name in baseline:
+            base_ms = baseline[name]["median_ms"]
+            median_ms = median_s * 1000.0
+            ratio = median_ms / base_ms if base_ms else 1.0
+            regressed = median_ms > base_ms * TOLERANCE + SLACK_MS
+            marker = "REGRESSION" if regressed else "OK"
+            print(f"  baseline    {base_ms:9.2f} ms -> {ratio:5.2f}x  [{marker}]")
+            if regressed:
+                failed = True
+        print()
+
+    if args.update_baseline:
+        with open(BASELINE_PATH, "w") as handle:
+            json.dump(results, handle, indent=2, sort_keys=True)
+        print(f"baseline written to {BASELINE_PATH}")
+    elif not baseline:
+        print("note: no baseline stored; run with --update-baseline to create one")
+
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -1,10 +1,18 @@
 #ifndef AST_H
 #define AST_H
+#include "ast_arena.h"
 #include "error_handler.h"
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
+// Ownership note: all AST nodes are allocated from the Parser's ASTArena
+// (see ast_arena.h) and referenced through raw non-owning pointers. The
+// whole tree is released at once when the arena is cleared or destroyed;
+// nothing in this file deletes a child node.
+
 // Forward Declarations
 class ASTVisitor;
 class Expression;
@@ -36,7 +44,7 @@ class StructDecl;
 class FunctionDecl;
 class ParameterDecl;
 
-enum class ASTNodeType {
+enum class ASTNodeType : unsigned char {
   // Base categories
   EXPRESSION,
   STATEMENT,
@@ -81,14 +89,33 @@ enum class ASTNodeType {
 // Base ASTNode Class
 // ============================================================================
 // Note: SourceLocation is defined in error_handler.h
+
+// Canonicalize a filename so every node referencing the same file shares
+// one stored string instead of owning a copy. A compile sees a handful of
+// distinct filenames, so the table stays tiny; the mutex makes it safe for
+// the parallel multi-file pipeline.
+inline const std::string *internAstFilename(const std::string &filename) {
+  static std::unordered_set<std::string> table;
+  static std::mutex table_mutex;
+  std::lock_guard<std::mutex> lock(table_mutex);
+  return &*table.insert(filename).first;
+}
+
 class ASTNode {
 protected:
+  // Packed header: one byte of node type plus a 16-byte location (interned
+  // filename pointer + line/column), instead of a full SourceLocation with
+  // an owning std::string per node. Keeps hot pointer-chasing passes from
+  // dragging a cold filename string into every cache line.
   ASTNodeType nodeType;
-  SourceLocation location;
+  const std::string *file; // Interned; never null
+  int line;
+  int column;
 
 public:
   ASTNode(ASTNodeType type, const SourceLocation &loc)
-      : nodeType(type), location(loc) {}
+      : nodeType(type), file(internAstFilename(loc.filename)), line(loc.line),
+        column(loc.column) {}
   virtual ~ASTNode() = default;
 
   // Visitor pattern support
@@ -96,9 +123,13 @@ public:
 
   // Getters
   ASTNodeType getNodeType() const { return nodeType; }
-  const SourceLocation &getLocation() const { return location; }
-  int getLine() const { return location.line; }
-  int getColumn() const { return location.column; }
+  // Materializes a SourceLocation on demand (diagnostics/serialization
+  // only); tree-walking passes should prefer getLine()/getColumn().
+  SourceLocation getLocation() const {
+    return SourceLocation(*file, line, column);
+  }
+  int getLine() const { return line; }
+  int getColumn() const { return column; }
 };
 
 // ============================================================================
@@ -174,45 +205,53 @@ public:
 // Binary Expression (e.g., a + b, x * y)
 class BinaryExpr : public Expression {
 private:
-  std::unique_ptr<Expression> left;
+  Expression *left;
   std::string op; // operator: +, -, *, /, ==, !=, <, >, etc.
-  std::unique_ptr<Expression> right;
+  Expression *right;
 
 public:
-  BinaryExpr(std::unique_ptr<Expression> lhs, std::string operation,
-             std::unique_ptr<Expression> rhs, const SourceLocation &loc)
-      : Expression(ASTNodeType::BINARY_EXPR, loc), left(std::move(lhs)),
-        op(operation), right(std::move(rhs)) {}
+  BinaryExpr(Expression *lhs, std::string operation,
+             Expression *rhs, const SourceLocation &loc)
+      : Expression(ASTNodeType::BINARY_EXPR, loc), left(lhs),
+        op(operation), right(rhs) {}
 
   void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 
-  Expression *getLeft() const { return left.get(); }
-  Expression *getRight() const { return right.get(); }
+  Expression *getLeft() const { return left; }
+  Expression *getRight() const { return right; }
   const std::string &getOperator() const { return op; }
 
   // USER STORY #11: Allow AST modification for implicit conversions
-  void setLeft(std::unique_ptr<Expression> expr) { left = std::move(expr); }
-  void setRight(std::unique_ptr<Expression> expr) { right = std::move(expr); }
-  std::unique_ptr<Expression> releaseLeft() { return std::move(left); }
-  std::unique_ptr<Expression> releaseRight() { return std::move(right); }
+  void setLeft(Expression *expr) { left = expr; }
+  void setRight(Expression *expr) { right = expr; }
+  Expression *releaseLeft() {
+    Expression *expr = left;
+    left = nullptr;
+    return expr;
+  }
+  Expression *releaseRight() {
+    Expression *expr = right;
+    right = nullptr;
+    return expr;
+  }
 };
 
 // Unary Expression (e.g., -x, !flag, *ptr, &var)
 class UnaryExpr : public Expression {
 private:
   std::string op; // operator: -, !, *, &, ++, --, etc.
-  std::unique_ptr<Expression> operand;
+  Expression *operand;
   bool prefixOp; // true for prefix (++x), false for postfix (x++)
 
 public:
-  UnaryExpr(std::string operation, std::unique_ptr<Expression> expr,
+  UnaryExpr(std::string operation, Expression *expr,
             bool prefix, const SourceLocation &loc)
       : Expression(ASTNodeType::UNARY_EXPR, loc), op(operation),
-        operand(std::move(expr)), prefixOp(prefix) {}
+        operand(expr), prefixOp(prefix) {}
 
   void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 
-  Expression *getOperand() const { return operand.get(); }
+  Expression *getOperand() const { return operand; }
   const std::string &getOperator() const { return op; }
   bool isPrefixOp() const { return prefixOp; }
 };
@@ -221,7 +260,7 @@ public:
 class SizeOfExpr : public Expression {
 private:
   std::string targetType;              // For sizeof(type)
-  std::unique_ptr<Expression> operand; // For sizeof(expr)
+  Expression *operand; // For sizeof(expr)
 
 public:
   // Constructor for sizeof(type)
@@ -230,14 +269,14 @@ public:
         operand(nullptr) {}
 
   // Constructor for sizeof(expression)
-  SizeOfExpr(std::unique_ptr<Expression> expr, const SourceLocation &loc)
+  SizeOfExpr(Expression *expr, const SourceLocation &loc)
       : Expression(ASTNodeType::SIZEOF_EXPR, loc), targetType(""),
-        operand(std::move(expr)) {}
+        operand(expr) {}
 
   void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 
   const std::string &getTargetType() const { return targetType; }
-  Expression *getOperand() const { return operand.get(); }
+  Expression *getOperand() const { return operand; }
   bool isTypeSize() const { return !targetType.empty(); }
 };
 
@@ -278,77 +317,74 @@ public:
 // Function Call Expression (e.g., foo(a, b, c))
 class CallExpr : public Expression {
 private:
-  std::unique_ptr<Expression> callee; // function being called
-  std::vector<std::unique_ptr<Expression>> arguments;
+  Expression *callee; // function being called
+  ASTSpan<Expression> arguments; // Arena-backed argument array
 
 public:
-  CallExpr(std::unique_ptr<Expression> func,
-           std::vector<std::unique_ptr<Expression>> args,
+  CallExpr(Expression *func, ASTSpan<Expression> args,
            const SourceLocation &loc)
-      : Expression(ASTNodeType::CALL_EXPR, loc), callee(std::move(func)),
-        arguments(std::move(args)) {}
+      : Expression(ASTNodeType::CALL_EXPR, loc), callee(func),
+        arguments(args) {}
 
   void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 
-  Expression *getCallee() const { return callee.get(); }
-  const std::vector<std::unique_ptr<Expression>> &getArguments() const {
-    return arguments;
-  }
+  Expression *getCallee() const { return callee; }
+  const ASTSpan<Expression> &getArguments() const { return arguments; }
 };
 
 // Assignment Expression (e.g., x = 5)
 class AssignmentExpr : public Expression {
 private:
-  std::unique_ptr<Expression> target; // left-hand side (usually identifier)
-  std::unique_ptr<Expression> value;  // right-hand side
+  Expression *target; // left-hand side (usually identifier)
+  Expression *value;  // right-hand side
 
 public:
-  AssignmentExpr(std::unique_ptr<Expression> lhs,
-                 std::unique_ptr<Expression> rhs, const SourceLocation &loc)
-      : Expression(ASTNodeType::ASSIGNMENT_EXPR, loc), target(std::move(lhs)),
-        value(std::move(rhs)) {}
+  AssignmentExpr(Expression *lhs,
+                 Expression *rhs, const SourceLocation &loc)
+      : Expression(ASTNodeType::ASSIGNMENT_EXPR, loc), target(lhs),
+        value(rhs) {}
 
   void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 
-  Expression *getTarget() const { return target.get(); }
-  Expression *getValue() const { return value.get(); }
+  Expression *getTarget() const { return target; }
+  Expression *getValue() const { return value; }
 };
 
 // Array Access Expression (e.g., arr[index] or arr[i + 1])
 class ArrayAccessExpr : public Expression {
 private:
-  std::unique_ptr<Expression> array; // array being accessed
-  std::unique_ptr<Expression> index; // index expression
+  Expression *array; // array being accessed
+  Expression *index; // index expression
 
 public:
-  ArrayAccessExpr(std::unique_ptr<Expression> arr,
-                  std::unique_ptr<Expression> idx, const SourceLocation &loc)
-      : Expression(ASTNodeType::ARRAY_ACCESS_EXPR, loc), array(std::move(arr)),
-        index(std::move(idx)) {}
+  ArrayAccessExpr(Expression *arr,
+                  Expression *idx, const SourceLocation &loc)
+      : Expression(ASTNodeType::ARRAY_ACCESS_EXPR, loc), array(arr),
+        index(idx) {}
 
   void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 
-  Expression *getArray() const { return array.get(); }
-  Expression *getIndex() const { return index.get(); }
+  Expression *getArray() const { return array; }
+  Expression *getIndex() const { return index; }
 };
 
 // Member Access Expression (e.g., point.x or ptr->y)
 // USER STORY #20
 class MemberAccessExpr : public Expression {
 private:
-  std::unique_ptr<Expression> object; // object/pointer being accessed
+  Expression *object; // object/pointer being accessed
   std::string memberName;             // name of the member
   bool isArrow;                       // true for ->, false for .
 
 public:
-  MemberAccessExpr(std::unique_ptr<Expression> obj, std::string member,
+  MemberAccessExpr(Expression *obj, std::string member,
                    bool arrow, const SourceLocation &loc)
       : Expression(ASTNodeType::MEMBER_ACCESS_EXPR, loc),
-        object(std::move(obj)), memberName(member), isArrow(arrow) {}
+        object(obj), memberName(member), isArrow(arrow) {}
 
   void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 
-  Expression *getObject() const { return object.get(); }
+  Expression *getObject() const { return object; }
   const std::string &getMemberName() const { return memberName; }
   bool getIsArrow() const { return isArrow; }
 };
@@ -357,23 +393,25 @@ public:
 // USER STORY #11: Implicit Type Conversions
 class TypeCastExpr : public Expression {
 private:
-  std::unique_ptr<Expression> operand; // expression being cast
+  Expression *operand; // expression being cast
   std::string targetType; // target type name (e.g., "int", "float")
   bool isImplicit;        // true for implicit conversions, false for explicit
 
 public:
-  TypeCastExpr(std::unique_ptr<Expression> expr, std::string target,
+  TypeCastExpr(Expression *expr, std::string target,
                bool implicit, const SourceLocation &loc)
-      : Expression(ASTNodeType::TYPE_CAST_EXPR, loc), operand(std::move(expr)),
+      : Expression(ASTNodeType::TYPE_CAST_EXPR, loc), operand(expr),
         targetType(target), isImplicit(implicit) {}
 
   void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 
-  Expression *getOperand() const { return operand.get(); }
-  std::unique_ptr<Expression> releaseOperand() { return std::move(operand); }
-  void setOperand(std::unique_ptr<Expression> expr) {
-    operand = std::move(expr);
+  Expression *getOperand() const { return operand; }
+  Expression *releaseOperand() {
+    Expression *expr = operand;
+    operand = nullptr;
+    return expr;
   }
+  void setOperand(Expression *expr) { operand = expr; }
   const std::string &getTargetType() const { return targetType; }
   bool getIsImplicit() const { return isImplicit; }
 };
@@ -381,22 +419,22 @@ public:
 // Ternary Expression (cond ? true : false)
 class TernaryExpr : public Expression {
 private:
-  std::unique_ptr<Expression> condition;
-  std::unique_ptr<Expression> trueExpr;
-  std::unique_ptr<Expression> falseExpr;
+  Expression *condition;
+  Expression *trueExpr;
+  Expression *falseExpr;
 
 public:
-  TernaryExpr(std::unique_ptr<Expression> cond,
-              std::unique_ptr<Expression> trueE,
-              std::unique_ptr<Expression> falseE, const SourceLocation &loc)
-      : Expression(ASTNodeType::TERNARY_EXPR, loc), condition(std::move(cond)),
-        trueExpr(std::move(trueE)), falseExpr(std::move(falseE)) {}
+  TernaryExpr(Expression *cond,
+              Expression *trueE,
+              Expression *falseE, const SourceLocation &loc)
+      : Expression(ASTNodeType::TERNARY_EXPR, loc), condition(cond),
+        trueExpr(trueE), falseExpr(falseE) {}
 
   void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 
-  Expression *getCondition() const { return condition.get(); }
-  Expression *getTrueExpr() const { return trueExpr.get(); }
-  Expression *getFalseExpr() const { return falseExpr.get(); }
+  Expression *getCondition() const { return condition; }
+  Expression *getTrueExpr() const { return trueExpr; }
+  Expression *getFalseExpr() const { return falseExpr; }
 };
 
 // ============================================================================
@@ -406,127 +444,123 @@ public:
 // If Statement (if-else)
 class IfStmt : public Statement {
 private:
-  std::unique_ptr<Expression> condition;
-  std::unique_ptr<Statement> thenBranch;
-  std::unique_ptr<Statement> elseBranch; // can be nullptr
+  Expression *condition;
+  Statement *thenBranch;
+  Statement *elseBranch; // can be nullptr
 
 public:
-  IfStmt(std::unique_ptr<Expression> cond, std::unique_ptr<Statement> thenStmt,
-         std::unique_ptr<Statement> elseStmt, const SourceLocation &loc)
-      : Statement(ASTNodeType::IF_STMT, loc), condition(std::move(cond)),
-        thenBranch(std::move(thenStmt)), elseBranch(std::move(elseStmt)) {}
+  IfStmt(Expression *cond, Statement *thenStmt,
+         Statement *elseStmt, const SourceLocation &loc)
+      : Statement(ASTNodeType::IF_STMT, loc), condition(cond),
+        thenBranch(thenStmt), elseBranch(elseStmt) {}
 
   void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 
-  Expression *getCondition() const { return condition.get(); }
-  Statement *getThenBranch() const { return thenBranch.get(); }
-  Statement *getElseBranch() const { return elseBranch.get(); }
+  Expression *getCondition() const { return condition; }
+  Statement *getThenBranch() const { return thenBranch; }
+  Statement *getElseBranch() const { return elseBranch; }
 };
 
 // While Statement
 class WhileStmt : public Statement {
 private:
-  std::unique_ptr<Expression> condition;
-  std::unique_ptr<Statement> body;
+  Expression *condition;
+  Statement *body;
 
 public:
-  WhileStmt(std::unique_ptr<Expression> cond,
-            std::unique_ptr<Statement> bodyStmt, const SourceLocation &loc)
-      : Statement(ASTNodeType::WHILE_STMT, loc), condition(std::move(cond)),
-        body(std::move(bodyStmt)) {}
+  WhileStmt(Expression *cond,
+            Statement *bodyStmt, const SourceLocation &loc)
+      : Statement(ASTNodeType::WHILE_STMT, loc), condition(cond),
+        body(bodyStmt) {}
 
   void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 
-  Expression *getCondition() const { return condition.get(); }
-  Statement *getBody() const { return body.get(); }
+  Expression *getCondition() const { return condition; }
+  Statement *getBody() const { return body; }
 };
 
 // For Statement
 class ForStmt : public Statement {
 private:
-  std::unique_ptr<Statement> initializer; // can be VarDecl or Expression
-  std::unique_ptr<Expression> condition;
-  std::unique_ptr<Expression> increment;
-  std::unique_ptr<Statement> body;
+  Statement *initializer; // can be VarDecl or Expression
+  Expression *condition;
+  Expression *increment;
+  Statement *body;
 
 public:
-  ForStmt(std::unique_ptr<Statement> init, std::unique_ptr<Expression> cond,
-          std::unique_ptr<Expression> inc, std::unique_ptr<Statement> bodyStmt,
+  ForStmt(Statement *init, Expression *cond,
+          Expression *inc, Statement *bodyStmt,
           const SourceLocation &loc)
-      : Statement(ASTNodeType::FOR_STMT, loc), initializer(std::move(init)),
-        condition(std::move(cond)), increment(std::move(inc)),
-        body(std::move(bodyStmt)) {}
+      : Statement(ASTNodeType::FOR_STMT, loc), initializer(init),
+        condition(cond), increment(inc),
+        body(bodyStmt) {}
 
   void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 
-  Statement *getInitializer() const { return initializer.get(); }
-  Expression *getCondition() const { return condition.get(); }
-  Expression *getIncrement() const { return increment.get(); }
-  Statement *getBody() const { return body.get(); }
+  Statement *getInitializer() const { return initializer; }
+  Expression *getCondition() const { return condition; }
+  Expression *getIncrement() const { return increment; }
+  Statement *getBody() const { return body; }
 };
 
 // Return Statement
 class ReturnStmt : public Statement {
 private:
-  std::unique_ptr<Expression> returnValue; // can be nullptr for void return
+  Expression *returnValue; // can be nullptr for void return
 
 public:
-  ReturnStmt(std::unique_ptr<Expression> value, const SourceLocation &loc)
+  ReturnStmt(Expression *value, const SourceLocation &loc)
       : Statement(ASTNodeType::RETURN_STMT, loc),
-        returnValue(std::move(value)) {}
+        returnValue(value) {}
 
   void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 
-  Expression *getReturnValue() const { return returnValue.get(); }
+  Expression *getReturnValue() const { return returnValue; }
 };
 
 // Compound Statement (block of statements)
 class CompoundStmt : public Statement {
 private:
-  std::vector<std::unique_ptr<Statement>> statements;
+  ASTSpan<Statement> statements; // Arena-backed statement array
 
 public:
-  CompoundStmt(std::vector<std::unique_ptr<Statement>> stmts,
-               const SourceLocation &loc)
-      : Statement(ASTNodeType::COMPOUND_STMT, loc),
-        statements(std::move(stmts)) {}
+  CompoundStmt(ASTSpan<Statement> stmts, const SourceLocation &loc)
+      : Statement(ASTNodeType::COMPOUND_STMT, loc), statements(stmts) {}
 
   void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 
-  const std::vector<std::unique_ptr<Statement>> &getStatements() const {
-    return statements;
-  }
+  const ASTSpan<Statement> &getStatements() const { return statements; }
 };
 
 // Expression Statement (expression used as a statement, e.g., x = 5;)
 class ExpressionStmt : public Statement {
 private:
-  std::unique_ptr<Expression> expression;
+  Expression *expression;
 
 public:
-  ExpressionStmt(std::unique_ptr<Expression> expr, const SourceLocation &loc)
+  ExpressionStmt(Expression *expr, const SourceLocation &loc)
       : Statement(ASTNodeType::EXPRESSION_STMT, loc),
-        expression(std::move(expr)) {}
+        expression(expr) {}
 
   void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 
-  Expression *getExpression() const { return expression.get(); }
+  Expression *getExpression() const { return expression; }
 };
 
 // Declaration Statement (wraps a declaration as a statement, e.g., int x = 5;
 // inside a function)
 class DeclStmt : public Statement {
 private:
-  std::unique_ptr<Declaration> declaration;
+  Declaration *declaration;
 
 public:
-  DeclStmt(std::unique_ptr<Declaration> decl, const SourceLocation &loc)
+  DeclStmt(Declaration *decl, const SourceLocation &loc)
       : Statement(ASTNodeType::EXPRESSION_STMT, loc),
-        declaration(std::move(decl)) {}
+        declaration(decl) {}
 
   void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 
-  Declaration *getDeclaration() const { return declaration.get(); }
+  Declaration *getDeclaration() const { return declaration; }
 };
 
 // Break Statement (break;)
@@ -556,29 +590,29 @@ class VarDecl : public Declaration {
 private:
   std::string name;
   std::string type;
-  std::unique_ptr<Expression> initializer; // can be nullptr
+  Expression *initializer; // can be nullptr
   bool isArray; // true if this is an array declaration
-  std::unique_ptr<Expression>
+  Expression *
       arraySize;    // size expression for arrays (can be nullptr)
   int pointerLevel; // number of pointer indirections (0 = not a pointer, 1 = *,
                     // 2 = **, etc.)
 
 public:
   VarDecl(std::string varName, std::string varType,
-          std::unique_ptr<Expression> init, const SourceLocation &loc,
-          bool array = false, std::unique_ptr<Expression> size = nullptr,
+          Expression *init, const SourceLocation &loc,
+          bool array = false, Expression *size = nullptr,
           int ptrLevel = 0)
       : Declaration(ASTNodeType::VAR_DECL, loc), name(varName), type(varType),
-        initializer(std::move(init)), isArray(array),
-        arraySize(std::move(size)), pointerLevel(ptrLevel) {}
+        initializer(init), isArray(array),
+        arraySize(size), pointerLevel(ptrLevel) {}
 
   void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 
   const std::string &getName() const { return name; }
   const std::string &getType() const { return type; }
-  Expression *getInitializer() const { return initializer.get(); }
+  Expression *getInitializer() const { return initializer; }
   bool getIsArray() const { return isArray; }
-  Expression *getArraySize() const { return arraySize.get(); }
+  Expression *getArraySize() const { return arraySize; }
   int getPointerLevel() const { return pointerLevel; }
   bool isPointer() const { return pointerLevel > 0; }
 };
@@ -605,21 +639,18 @@ public:
 class StructDecl : public Declaration {
 private:
   std::string name;
-  std::vector<std::unique_ptr<VarDecl>> fields;
+  ASTSpan<VarDecl> fields; // Arena-backed field array
 
 public:
-  StructDecl(std::string structName,
-             std::vector<std::unique_ptr<VarDecl>> members,
+  StructDecl(std::string structName, ASTSpan<VarDecl> members,
              const SourceLocation &loc)
       : Declaration(ASTNodeType::STRUCT_DECL, loc), name(structName),
-        fields(std::move(members)) {}
+        fields(members) {}
 
   void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 
   const std::string &getName() const { return name; }
-  const std::vector<std::unique_ptr<VarDecl>> &getFields() const {
-    return fields;
-  }
+  const ASTSpan<VarDecl> &getFields() const { return fields; }
 };
 
 // Function Declaration
@@ -627,27 +658,24 @@ class FunctionDecl : public Declaration {
 private:
   std::string name;
   std::string returnType;
-  std::vector<std::unique_ptr<ParameterDecl>> parameters;
-  std::unique_ptr<CompoundStmt> body; // can be nullptr for forward declarations
+  ASTSpan<ParameterDecl> parameters; // Arena-backed parameter array
+  CompoundStmt *body; // can be nullptr for forward declarations
   bool isExtern;
 
 public:
   FunctionDecl(std::string funcName, std::string retType,
-               std::vector<std::unique_ptr<ParameterDecl>> params,
-               std::unique_ptr<CompoundStmt> funcBody,
+               ASTSpan<ParameterDecl> params, CompoundStmt *funcBody,
                const SourceLocation &loc, bool external = false)
       : Declaration(ASTNodeType::FUNCTION_DECL, loc), name(funcName),
-        returnType(retType), parameters(std::move(params)),
-        body(std::move(funcBody)), isExtern(external) {}
+        returnType(retType), parameters(params),
+        body(funcBody), isExtern(external) {}
 
   void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 
   const std::string &getName() const { return name; }
   const std::string &getReturnType() const { return returnType; }
-  const std::vector<std::unique_ptr<ParameterDecl>> &getParameters() const {
-    return parameters;
-  }
-  CompoundStmt *getBody() const { return body.get(); }
+  const ASTSpan<ParameterDecl> &getParameters() const { return parameters; }
+  CompoundStmt *getBody() const { return body; }
   bool getIsExtern() const { return isExtern; }
 };
 
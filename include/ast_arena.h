@@ -0,0 +1,129 @@
+#ifndef AST_ARENA_H
+#define AST_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// ASTSpan - Arena-backed child array
+// ============================================================================
+// A fixed-size view over a pointer array allocated from the arena. List
+// shaped nodes (CompoundStmt, CallExpr, ...) store one of these instead of
+// a std::vector, so a node's children sit in a single contiguous arena
+// block with no separate heap allocation or capacity slack.
+template <typename T> class ASTSpan {
+public:
+  ASTSpan() : data_(nullptr), size_(0) {}
+  ASTSpan(T *const *data, unsigned size) : data_(data), size_(size) {}
+
+  T *const *begin() const { return data_; }
+  T *const *end() const { return data_ + size_; }
+  T *operator[](size_t i) const { return data_[i]; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+private:
+  T *const *data_;
+  unsigned size_;
+};
+
+// ============================================================================
+// ASTArena - Bump allocator for AST nodes
+// ============================================================================
+// Nodes are placement-new'd into large slabs and handed out as raw
+// non-owning pointers; the arena owns every node it creates. Allocation is
+// a pointer bump, and teardown is one flat loop instead of the recursive
+// unique_ptr destructor cascade a deep tree used to trigger. Node classes
+// that own heap memory (std::string members, child vectors) register a
+// destructor so that memory is still reclaimed; fully trivial nodes cost
+// nothing at teardown.
+class ASTArena {
+public:
+  ASTArena() = default;
+  ~ASTArena() { clear(); }
+
+  // Non-copyable, non-movable: created nodes hold no back-pointer to the
+  // arena, so its address must stay stable.
+  ASTArena(const ASTArena &) = delete;
+  ASTArena &operator=(const ASTArena &) = delete;
+
+  // Allocate and construct a node. The returned pointer is valid until
+  // clear() or the arena's destruction; callers never delete it.
+  template <typename T, typename... Args> T *create(Args &&...args) {
+    void *mem = allocate(sizeof(T), alignof(T));
+    T *node = new (mem) T(std::forward<Args>(args)...);
+    if (!std::is_trivially_destructible<T>::value) {
+      destructors_.push_back(
+          {node, [](void *p) { static_cast<T *>(p)->~T(); }});
+    }
+    return node;
+  }
+
+  // Copy a vector of node pointers into a contiguous arena block and
+  // return a span over it. Used by the parser to freeze child lists.
+  template <typename T> ASTSpan<T> makeSpan(const std::vector<T *> &items) {
+    if (items.empty()) {
+      return ASTSpan<T>();
+    }
+    T **array = static_cast<T **>(
+        allocate(items.size() * sizeof(T *), alignof(T *)));
+    for (size_t i = 0; i < items.size(); ++i) {
+      array[i] = items[i];
+    }
+    return ASTSpan<T>(array, static_cast<unsigned>(items.size()));
+  }
+
+  // Destroy every node and release all slabs. Runs registered destructors
+  // in reverse creation order (children after parents is fine: nodes only
+  // free their own members, never other nodes).
+  void clear() {
+    for (auto it = destructors_.rbegin(); it != destructors_.rend(); ++it) {
+      it->destroy(it->object);
+    }
+    destructors_.clear();
+    slabs_.clear();
+    cursor_ = nullptr;
+    slab_end_ = nullptr;
+  }
+
+  // Total bytes handed out (for stats/instrumentation).
+  size_t bytesAllocated() const { return bytes_allocated_; }
+  size_t slabCount() const { return slabs_.size(); }
+
+private:
+  // 64 KiB slabs: large enough that a typical function body fits in a
+  // handful of contiguous blocks, small enough not to waste memory on
+  // tiny inputs. Nodes bigger than a slab get a dedicated one.
+  static constexpr size_t kSlabSize = 64 * 1024;
+
+  void *allocate(size_t size, size_t align) {
+    char *aligned = reinterpret_cast<char *>(
+        (reinterpret_cast<uintptr_t>(cursor_) + align - 1) & ~(align - 1));
+    if (aligned + size > slab_end_ || cursor_ == nullptr) {
+      size_t slab_size = size > kSlabSize ? size : kSlabSize;
+      slabs_.push_back(std::unique_ptr<char[]>(new char[slab_size]));
+      cursor_ = slabs_.back().get();
+      slab_end_ = cursor_ + slab_size;
+      aligned = cursor_; // operator new[] storage is maximally aligned
+    }
+    cursor_ = aligned + size;
+    bytes_allocated_ += size;
+    return aligned;
+  }
+
+  struct Destructor {
+    void *object;
+    void (*destroy)(void *);
+  };
+
+  std::vector<std::unique_ptr<char[]>> slabs_;
+  char *cursor_ = nullptr;
+  char *slab_end_ = nullptr;
+  std::vector<Destructor> destructors_;
+  size_t bytes_allocated_ = 0;
+};
+
+#endif // AST_ARENA_H
@@ -44,15 +44,31 @@ struct LiveInterval
     int end;                   // Last instruction that uses this value
     X86Register assignedReg;   // Allocated register (NONE if spilled)
     int spillSlot;             // Stack slot if spilled (-1 if not spilled)
+    int useCount;              // Number of defs+uses (for spill weighting)
+    double weightedUseCount;   // Uses weighted by loop depth at each use
+    bool crossesCall;          // Live across at least one CALL
+    std::vector<int> usePositions; // Instruction index of every def/use
 
     LiveInterval(SSAValue* val, int s, int e)
         : value(val), start(s), end(e),
-          assignedReg(X86Register::NONE), spillSlot(-1) {}
+          assignedReg(X86Register::NONE), spillSlot(-1),
+          useCount(1), weightedUseCount(1.0), crossesCall(false) {}
 
     bool overlaps(const LiveInterval& other) const {
         return !(end < other.start || other.end < start);
     }
 
+    // Use-density spill weight: frequently-used short intervals are
+    // expensive to spill; long sparse ones are cheap. Uses inside loops
+    // count more (weightedUseCount multiplies each use by 4 per loop
+    // level), and call-crossing intervals are additionally discounted
+    // since keeping them in a caller-saved register costs a save/restore
+    // at every call anyway.
+    double spillWeight() const {
+        double density = weightedUseCount / (end - start + 1);
+        return crossesCall ? density * 0.5 : density;
+    }
+
     bool operator<(const LiveInterval& other) const {
         return start < other.start;
     }
@@ -69,10 +85,28 @@ struct LiveInterval
 class LinearScanAllocator
 {
 public:
+    // Allocation strategy. LINEAR_SCAN is the fast single-pass default;
+    // GRAPH_COLORING builds an interference graph from the same live
+    // intervals and colors it with move-affinity preferences — slower but
+    // better allocation for release builds. Huge functions automatically
+    // fall back to linear scan.
+    enum class Mode { LINEAR_SCAN, GRAPH_COLORING };
+
     // All live intervals sorted by start point (public for CodeGenerator access)
     std::vector<LiveInterval> intervals;
 
 private:
+    Mode mode_ = Mode::LINEAR_SCAN;
+
+    // Move-related value pairs (result id, source id) gathered during
+    // interval building; the graph allocator prefers giving both the same
+    // color so the mov disappears as a self-move in the peephole.
+    std::vector<std::pair<ValueId, ValueId>> movePairs;
+
+    // Graph-coloring implementation (Chaitin-Briggs style simplify/select
+    // over the interval interference graph)
+    void allocateGraphColoring();
+
     // Available general-purpose registers for allocation
     // RSP and RBP are reserved for stack management
     std::vector<X86Register> availableRegisters;
@@ -80,6 +114,14 @@ private:
     // Active intervals currently using registers
     std::vector<LiveInterval*> active;
 
+    // Every interval ever assigned to each register, for the second-chance
+    // binpacking pass (holes are ranges no assigned interval covers)
+    std::unordered_map<X86Register, std::vector<const LiveInterval*>> registerAssignments;
+
+    // ValueId -> interval index, so getRegister()/isSpilled()/getSpillSlot()
+    // are hash lookups instead of linear scans with string compares
+    std::unordered_map<ValueId, size_t> valueToInterval;
+
     // Spill counter
     int nextSpillSlot;
 
@@ -95,10 +137,18 @@ private:
     // Helper: Expire old intervals that no longer need registers
     void expireOldIntervals(LiveInterval* current);
 
+    // Second-chance pass: try to binpack spilled intervals into lifetime
+    // holes left in already-used registers
+    void secondChancePass();
+
 public:
     LinearScanAllocator();
     ~LinearScanAllocator() = default;
 
+    // Select the allocation strategy (before allocate())
+    void setMode(Mode mode) { mode_ = mode; }
+    Mode getMode() const { return mode_; }
+
     // Build live intervals from IR function
     void buildLiveIntervals(IRFunction* function);
 
@@ -121,32 +171,92 @@ public:
     void printAllocation() const;
 };
 
+// ============================================================================
+// Machine Instruction - Structured assembly representation
+// ============================================================================
+// Each emitted line is parsed exactly once into this form; peephole
+// patterns then match on opcode/operand fields instead of re-scanning and
+// re-parsing text per pattern. Untouched lines render back verbatim.
+
+struct MachineOperand
+{
+    enum class Kind
+    {
+        REGISTER,  // %rax
+        IMMEDIATE, // $42
+        MEMORY,    // -8(%rbp)
+        OTHER      // Labels and anything unrecognized
+    };
+
+    Kind kind = Kind::OTHER;
+    std::string reg;    // REGISTER: register name including '%'
+    long long imm = 0;  // IMMEDIATE: parsed value
+    std::string base;   // MEMORY: base register including '%'
+    long long disp = 0; // MEMORY: displacement
+    std::string text;   // Original spelling (always valid)
+};
+
+struct MachineInstr
+{
+    enum class Kind
+    {
+        INSTRUCTION, // opcode + operands
+        LABEL_DEF,   // "name:"
+        COMMENT,     // "# ..."
+        DIRECTIVE,   // ".globl" etc.
+        BLANK
+    };
+
+    Kind kind = Kind::BLANK;
+    std::string opcode;                 // INSTRUCTION only
+    std::vector<MachineOperand> operands;
+    std::string raw;                    // Original line (with newline)
+    bool modified = false;              // Render from fields, not raw
+    bool dead = false;                  // Marked for removal (compacted in one pass)
+
+    bool isInstruction() const { return kind == Kind::INSTRUCTION && !dead; }
+    std::string render() const;
+};
+
 // ============================================================================
 // Peephole Optimizer - Assembly-level optimizations
 // ============================================================================
-// Performs local optimizations on generated assembly code
-// - Removes redundant instructions (mov %rax, %rax)
-// - Optimizes arithmetic with constants (add $0, mul by powers of 2)
-// - Eliminates consecutive push/pop pairs
-// - Simplifies instruction sequences
+// Performs local optimizations on the structured machine-instruction
+// buffer:
+// - Removes redundant moves (mov %rax, %rax) and arithmetic with zero
+// - Strength-reduces multiply by powers of two to shifts
+// - Eliminates push/pop pairs and overwritten comparisons
+// - Eliminates spill-reload pairs (store to a slot, reload from it)
+// - Rewrites cmp $0 as test and fuses mov+add-immediate into lea
 
 class PeepholeOptimizer
 {
 private:
-    std::vector<std::string> instructions;  // Assembly instructions
+    std::vector<MachineInstr> instructions; // Parsed assembly lines
     bool optimizationEnabled;
 
-    // Optimization pattern detection
-    bool isRedundantMove(const std::string& inst) const;
-    bool isArithmeticWithZero(const std::string& inst) const;
-    bool isMultiplyByPowerOfTwo(const std::string& inst, int& shiftAmount) const;
-    bool isPushPopPair(size_t index) const;
-    bool isRedundantComparison(size_t index) const;
-
-    // Optimization transformations
-    std::string optimizeMultiplyToShift(const std::string& inst, int shiftAmount) const;
-    void removeInstruction(size_t index);
-    void replaceInstruction(size_t index, const std::string& newInst);
+    // Parse one emitted line into a MachineInstr (done once per line)
+    static MachineInstr parseLine(const std::string& line);
+    static MachineOperand parseOperand(const std::string& text);
+
+    // Index of the next real instruction at or after `index` (skips
+    // comments/blanks); instructions.size() if none.
+    size_t nextInstruction(size_t index) const;
+
+    // Field-matching passes; each returns the number of changes made
+    int removeRedundantMoves();
+    int removeArithmeticWithZero();
+    int strengthReduceMultiplies();
+    int removePushPopPairs();
+    int removeOverwrittenComparisons();
+    int removeSpillReloads();
+    int rewriteCompareZeroAsTest();
+    int fuseLea();
+
+    // Drop instructions marked dead in one O(n) compaction (patterns mark
+    // instead of erasing, avoiding quadratic vector::erase churn on
+    // branch-dense functions)
+    void compact();
 
 public:
     PeepholeOptimizer();
@@ -165,7 +275,7 @@ public:
     std::string getOptimizedCode() const;
 
     // Get optimization statistics
-    int getInstructionCount() const { return instructions.size(); }
+    int getInstructionCount() const { return static_cast<int>(instructions.size()); }
 
     // Reset optimizer
     void reset();
@@ -302,12 +412,24 @@ public:
     // Main API
     // ========================================================================
 
+    // Select the register allocation strategy ("graph" enables the
+    // graph-coloring allocator; anything else keeps linear scan)
+    void setRegisterAllocationMode(const std::string& mode) {
+        allocator.setMode(mode == "graph"
+                              ? LinearScanAllocator::Mode::GRAPH_COLORING
+                              : LinearScanAllocator::Mode::LINEAR_SCAN);
+    }
+
     // Generate x86-64 assembly for a single function
     std::string generateFunction(IRFunction* function);
 
     // Generate x86-64 assembly for multiple functions
     std::string generateProgram(const std::vector<std::unique_ptr<IRFunction>>& functions);
 
+    // Same, over borrowed pointers (used by incremental compilation, where
+    // some functions are owned by the driver's cache)
+    std::string generateProgram(const std::vector<IRFunction*>& functions);
+
     // Get generated assembly code
     std::string getAssembly() const { return output.str(); }
 
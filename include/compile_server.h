@@ -0,0 +1,43 @@
+#ifndef COMPILE_SERVER_H
+#define COMPILE_SERVER_H
+
+#include "compiler_driver.h"
+
+#include <string>
+
+// ============================================================================
+// Compile Server - Persistent daemon mode for mycc
+// ============================================================================
+// A long-lived process listening on a Unix domain socket. Each connection
+// carries one JSON request ({"source": "...", "filename": "..."}) and gets
+// one JSON response with the visualization dumps (tokens, ast, assembly)
+// plus captured diagnostics. Keeping the process alive means process
+// startup, the IR string table and every other process-wide cache are paid
+// once instead of per keystroke.
+//
+// Protocol: the client writes its request and half-closes the connection
+// (shutdown(SHUT_WR)); the server reads to EOF, writes the response, and
+// closes. One request per connection keeps framing trivial for the Flask
+// bridge.
+class CompileServer
+{
+public:
+    explicit CompileServer(const std::string& socketPath);
+
+    // Bind, listen and serve until the process is terminated.
+    // Returns a process exit code (non-zero on setup failure).
+    int run();
+
+private:
+    std::string socketPath_;
+
+    // One driver for the daemon's lifetime: its per-function IR cache
+    // carries across requests, so the visualization edit loop recompiles
+    // only the functions whose fingerprint actually changed.
+    CompilerDriver driver_;
+
+    // Run the in-process pipeline for one request and build the response.
+    std::string handleRequest(const std::string& requestJson);
+};
+
+#endif // COMPILE_SERVER_H
@@ -1,10 +1,15 @@
 #ifndef COMPILER_DRIVER_H
 #define COMPILER_DRIVER_H
 
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 
+class IRFunction;
+
 // ============================================================================
 // Compiler Driver - End-to-End Compilation Pipeline
 // ============================================================================
@@ -33,13 +38,20 @@ public:
         bool emitAssembly = false;      // Stop after assembly generation
         bool emitObject = false;        // Stop after assembling
         bool linkWithCRT = true;        // Link with C runtime (for main)
+        bool directObject = false;      // Emit ELF .o directly, skipping `as`
+        bool noTempFiles = false;       // Stream to as/ld via pipes and memfd
+        std::string regalloc = "linear"; // Register allocator: "linear" or "graph"
+        int jobs = 0;                   // Worker threads for multi-file compiles (0 = all cores)
         std::vector<std::string> linkLibraries;  // Additional libraries to link
 
         // Data dump options for visualization/debugging
         std::string dumpTokensPath;     // Dump token stream as JSON (empty = no dump)
+        std::string dumpTokensBinPath;  // Dump token stream in binary MTK1 format (empty = no dump)
         std::string dumpAstPath;        // Dump AST as JSON (empty = no dump)
         std::string dumpAsmPath;        // Dump assembly text (empty = no dump)
         std::string dumpHexPath;        // Dump hex output (empty = no dump)
+        std::string dumpOptStatsPath;   // Dump per-pass optimizer stats as JSON (empty = no dump)
+        std::string dumpTimingPath;     // Dump per-phase timing/memory as JSON (empty = no dump)
     };
 
 private:
@@ -47,11 +59,51 @@ private:
     std::string tempDir;
     int errorCount;
 
+    // ========================================================================
+    // Incremental compilation state
+    // ========================================================================
+    // Per-function cache reused across compileIncremental() calls on the
+    // same driver instance (the visualization API edit loop). Keyed by
+    // function name; an entry holds the location-insensitive fingerprint of
+    // the function's AST plus its already-optimized IR.
+    struct CachedFunction {
+        uint64_t fingerprint;
+        std::unique_ptr<IRFunction> ir;
+    };
+    std::unordered_map<std::string, CachedFunction> functionCache_;
+
     // Helper methods
     std::string getTempFileName(const std::string& baseName, const std::string& extension);
     bool runCommand(const std::string& command, std::string& output);
     bool writeAssemblyFile(const std::string& assembly, const std::string& filename);
     bool assembleFile(const std::string& asmFile, const std::string& objFile);
+
+    // Zero-temp-file backend (--no-temp-files): streams the assembly text
+    // to `as` over a pipe, receives the object into a memfd, and hands the
+    // linker the same in-memory object through /proc/self/fd. No .s or .o
+    // ever touches the filesystem, so cleanup() has nothing to do.
+    bool assembleAndLinkInMemory(const std::string& assembly,
+                                 const std::string& sourceName);
+
+    // Run argv with `stdinData` piped to its stdin, capturing combined
+    // stdout/stderr. Returns true when the child exits 0.
+    bool runPipedCommand(const std::vector<std::string>& argv,
+                         const std::string* stdinData, std::string& output);
+
+    // Shared incremental core: fingerprint every function against the
+    // cache, regenerate and re-optimize only the changed ones, and fill
+    // `out` with borrowed pointers (the cache keeps ownership). Returns
+    // false with `error` set if IR generation throws.
+    bool regenerateChangedFunctions(const std::vector<class Declaration*>& ast,
+                                    class IRCodeGenerator& irCodeGen,
+                                    std::vector<IRFunction*>& out,
+                                    size_t& reusedCount, std::string& error);
+
+    // Worker-thread pipeline for one file: lex through assemble, with all
+    // diagnostics captured into `diagnostics` instead of stderr so
+    // compileMultiple can merge per-file output deterministically.
+    bool compileToObject(const std::string& sourcePath, const std::string& asmFile,
+                         const std::string& objFile, std::string& diagnostics);
     bool linkFiles(const std::vector<std::string>& objFiles, const std::string& executable);
     void cleanup(const std::vector<std::string>& files);
     void reportError(const std::string& message);
@@ -60,11 +112,48 @@ private:
 public:
     CompilerDriver();
     explicit CompilerDriver(const Options& opts);
-    ~CompilerDriver() = default;
+    ~CompilerDriver(); // Out-of-line: the IR cache needs IRFunction complete
 
     // Main compilation entry point
     // Returns true if compilation succeeded, false otherwise
-    bool compile(const std::string& sourceCode, const std::string& sourceName = "input.c");
+    // Takes a view so mmap-backed buffers compile without a heap copy.
+    bool compile(std::string_view sourceCode, const std::string& sourceName = "input.c");
+
+    // Memory-map the file at `sourcePath` and compile it in place.
+    // Compile startup cost is page-fault time; no heap copy of the source.
+    bool compileFile(const std::string& sourcePath);
+
+    // Incremental recompile for the interactive edit loop: the file is
+    // re-lexed and re-parsed (cheap), but semantic analysis results feed IR
+    // generation and optimization only for functions whose AST fingerprint
+    // changed since the previous call on this driver; unchanged functions
+    // reuse their cached optimized IR. Any edit to globals, structs or a
+    // function signature invalidates the whole cache (those can change the
+    // meaning of every body). Falls back to full work on the first call.
+    bool compileIncremental(std::string_view sourceCode,
+                            const std::string& sourceName = "input.c");
+
+    // Drop all incremental state (e.g. when switching files)
+    void clearIncrementalCache();
+
+    // In-memory result of compileForVisualization(): everything the
+    // visualization API serves, with diagnostics buffered instead of
+    // written to stderr and no files touched.
+    struct VisualizationResult {
+        bool success = false;
+        std::string error;       // Failing stage when !success
+        std::string diagnostics; // Buffered ErrorHandler output
+        std::string tokensJson;  // Always produced (lexing runs first)
+        std::string astJson;     // Empty until parsing succeeds
+        std::string assembly;    // Empty until codegen runs
+    };
+
+    // Incremental pipeline for a long-lived visualization consumer (the
+    // compile daemon): reuses the per-function IR cache across calls on
+    // this driver, so a keystroke edit re-runs IR generation and
+    // optimization only for the functions whose fingerprint changed.
+    VisualizationResult compileForVisualization(std::string_view sourceCode,
+                                                const std::string& sourceName = "input.c");
 
     // Compile multiple source files
     bool compileMultiple(const std::vector<std::string>& sourceFiles);
@@ -78,6 +167,15 @@ public:
 
     // Static helper: Generate C runtime startup code for standalone executables
     static std::string generateStartupCode();
+
+private:
+    // Path to the pre-assembled startup object for standalone (-nostdlib
+    // style) links. Assembled at most once per mycc install: the object is
+    // cached under XDG_CACHE_HOME (or ~/.cache) keyed by a content hash of
+    // the startup assembly, so every subsequent compile links the cached
+    // .o without invoking the assembler. Returns an empty string when the
+    // object can neither be found nor built.
+    std::string getStartupObject();
 };
 
 #endif // COMPILER_DRIVER_H
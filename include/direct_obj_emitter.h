@@ -0,0 +1,77 @@
+#ifndef DIRECT_OBJ_EMITTER_H
+#define DIRECT_OBJ_EMITTER_H
+
+#include "elf_writer.h"
+#include "ir.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ============================================================================
+// Direct Object Emitter - x86-64 machine code straight from the IR
+// ============================================================================
+// The fast path behind --direct-obj: encodes each IRFunction directly to
+// machine code and writes a relocatable ELF .o via ElfObjectWriter, so the
+// common compile never formats megabytes of AT&T text only to have `as`
+// re-parse it in a child process. The textual CodeGenerator remains the
+// path for -S and the visualization dumps.
+//
+// Code quality is deliberately simple — every SSA value lives in a stack
+// slot and instructions go through %rax/%rcx — because the goal of this
+// path is compile speed, not generated-code speed. Anything outside the
+// supported integer subset (floats, pointers/LOAD/STORE, >6 parameters,
+// non-integer constants) makes emit() return false and the caller falls
+// back to the textual pipeline for the whole translation unit.
+class DirectObjectEmitter
+{
+public:
+    // Encode all functions and write `objPath`. Returns false without
+    // writing anything if an unsupported construct is encountered; the
+    // reason is available via getUnsupportedReason().
+    bool emit(const std::vector<IRFunction*>& functions,
+              const std::string& objPath);
+
+    const std::string& getUnsupportedReason() const { return reason_; }
+
+private:
+    // Per-function encoding state
+    std::vector<uint8_t> text_;
+    ElfObjectWriter writer_;
+    std::unordered_map<ValueId, int> slots_;      // SSA value -> frame slot
+    std::unordered_map<std::string, uint64_t> labelOffsets_;
+    struct Fixup
+    {
+        uint64_t pos;      // Offset of the rel32 to patch
+        std::string label; // Jump target
+        bool conditional;  // je (0F 84) vs jmp (E9)
+    };
+    std::vector<Fixup> fixups_;
+    // Call sites for the current function; registered with the ELF writer
+    // only after branch relaxation has settled final offsets
+    std::vector<std::pair<uint64_t, std::string>> callSites_;
+    std::string reason_;
+
+    // Single-fixup-pass branch resolution with relaxation: branches whose
+    // displacement fits in rel8 are rewritten to the 2-byte short forms,
+    // with label, frame and call-site offsets adjusted accordingly.
+    bool resolveBranches(uint64_t functionStart);
+
+    bool emitFunction(IRFunction* function);
+    bool encodeInstruction(const IRInstruction* inst);
+
+    // Encoding helpers (see .cpp for the instruction forms)
+    int slotFor(const SSAValue& value);
+    int32_t slotDisp(int slot) const { return -8 * (slot + 1); }
+    bool loadOperand(const IROperand& operand, int reg);
+    void storeResultFromRax(const SSAValue* result);
+    bool constantValue(const IROperand& operand, int64_t& value);
+
+    void byte(uint8_t b) { text_.push_back(b); }
+    void bytes(std::initializer_list<uint8_t> list);
+    void imm32(int32_t value);
+    void emitProloguePlaceholder(size_t& frameSizePos);
+    bool fail(const std::string& reason);
+};
+
+#endif // DIRECT_OBJ_EMITTER_H
@@ -0,0 +1,50 @@
+#ifndef ELF_WRITER_H
+#define ELF_WRITER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// ELF Object Writer - Emits relocatable x86-64 ELF object files
+// ============================================================================
+// Takes finished machine-code bytes plus symbol and relocation records and
+// writes a minimal but fully valid ET_REL file: .text, .symtab, .strtab,
+// .shstrtab and .rela.text sections. Used by the direct-object fast path
+// so a compile never shells out to the external assembler.
+class ElfObjectWriter
+{
+public:
+    // Define a global function symbol at `offset` within .text.
+    void addFunction(const std::string& name, uint64_t offset, uint64_t size);
+
+    // Record a call-site relocation: the 4 bytes at `offset` in .text are
+    // the rel32 of a CALL to `symbol` (R_X86_64_PLT32, addend -4). The
+    // symbol may be one of our functions or an undefined external.
+    void addCallRelocation(uint64_t offset, const std::string& symbol);
+
+    void setText(std::vector<uint8_t> bytes) { text_ = std::move(bytes); }
+
+    // Write the object file; returns false (with errno untouched beyond
+    // the failed I/O) if the file cannot be written.
+    bool write(const std::string& path) const;
+
+private:
+    struct Symbol
+    {
+        std::string name;
+        uint64_t offset;
+        uint64_t size;
+    };
+    struct Relocation
+    {
+        uint64_t offset;
+        std::string symbol;
+    };
+
+    std::vector<uint8_t> text_;
+    std::vector<Symbol> functions_;
+    std::vector<Relocation> relocations_;
+};
+
+#endif // ELF_WRITER_H
@@ -2,6 +2,7 @@
 #define ERROR_HANDLER_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <iostream>
 #include <memory>
@@ -75,6 +76,14 @@ struct Diagnostic {
 //
 // ============================================================================
 
+// A registered source file: a non-owning view of its text plus a lazily
+// built line-offset index. The index is only constructed when the first
+// diagnostic needs a source line, so clean compiles never pay for it.
+struct RegisteredSource {
+    std::string_view text;
+    mutable std::vector<size_t> line_offsets;  // Start offset of each line (lazy)
+};
+
 class ErrorHandler {
 public:
     // Constructor
@@ -152,11 +161,18 @@ public:
     // Check if source context is enabled
     bool is_source_context_enabled() const { return show_source_context_; }
 
-    // Register source code for a file (for context display)
-    void register_source(const std::string& filename, const std::string& source_code);
+    // Redirect diagnostic output to `os` instead of std::cerr (nullptr
+    // restores std::cerr). Used by parallel compilation to buffer each
+    // file's diagnostics and emit them in a deterministic order.
+    void set_output_stream(std::ostream* os) { output_stream_ = os; }
+
+    // Register source code for a file (for context display). Zero-copy:
+    // only a view is stored, so the caller (lexer, mmap'd SourceBuffer)
+    // must keep the underlying buffer alive for this handler's lifetime.
+    void register_source(const std::string& filename, std::string_view source_code);
 
     // Get registered source files (for sharing between error handlers)
-    const std::unordered_map<std::string, std::string>& get_source_files() const { return source_files_; }
+    const std::unordered_map<std::string, RegisteredSource>& get_source_files() const { return source_files_; }
 
     // ========================================================================
     // Utility Methods
@@ -185,7 +201,11 @@ private:
     bool colors_enabled_;                  // Color output enabled
     int max_errors_;                       // Maximum errors (0 = unlimited)
     bool show_source_context_;             // Show source code context
-    std::unordered_map<std::string, std::string> source_files_;  // filename -> source code
+    std::ostream* output_stream_;          // Diagnostic sink (nullptr = std::cerr)
+    std::unordered_map<std::string, RegisteredSource> source_files_;  // filename -> source view
+
+    // Resolve the active diagnostic output stream
+    std::ostream& out() const { return output_stream_ ? *output_stream_ : std::cerr; }
 
     // ========================================================================
     // Internal Helper Methods
@@ -200,7 +220,8 @@ private:
     // Get diagnostic level name (ERROR, WARNING, NOTE)
     std::string get_level_name(DiagnosticLevel level) const;
 
-    // Extract a specific line from source code
+    // Extract a specific line from source code (builds the file's line
+    // index on first use)
     std::string get_source_line(const std::string& filename, int line_number) const;
 
     // Display source code context with caret pointing to error location
@@ -1,9 +1,13 @@
 #ifndef IR_H
 #define IR_H
 
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
-#include <variant>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 // ============================================================================
@@ -19,34 +23,91 @@ class IRBasicBlock;
 class IRFunction;
 class TempVarGenerator;
 
+// Dense integer id of an interned IR string (value name, type, constant
+// spelling or label). Values/operands carry these 4-byte ids; the text
+// behind an id exists once in the IRStringTable and is only fetched for
+// dumps and final assembly emission.
+using ValueId = uint32_t;
+
+// ============================================================================
+// IR String Table - Global interner backing ValueId
+// ============================================================================
+// Process-wide and append-only: ids handed out stay valid forever, so IR
+// cached across incremental compiles or built on worker threads can share
+// one table. The mutex only guards table mutation/probing; returned string
+// references are stable.
+class IRStringTable
+{
+public:
+  static IRStringTable &instance();
+
+  // Id for `text`, interning it on first sight.
+  ValueId intern(const std::string &text);
+
+  // Canonical spelling behind an id.
+  const std::string &text(ValueId id) const;
+
+private:
+  IRStringTable() = default;
+  IRStringTable(const IRStringTable &) = delete;
+  IRStringTable &operator=(const IRStringTable &) = delete;
+
+  mutable std::mutex mutex_;
+  std::deque<std::string> texts_; // id -> text; deque keeps references stable
+  std::unordered_map<std::string_view, ValueId> index_; // views into texts_
+};
+
 // ============================================================================
 // SSA Value - Represents a value in SSA form
 // ============================================================================
+// Three interned ids plus the version: 16 trivially-copyable bytes. The
+// full SSA name ("x_1") is interned once at construction, so getSSAName()
+// is a table read instead of a fresh concatenation, and two values denote
+// the same SSA variable iff their getId()s are equal.
 class SSAValue
 {
 private:
-  std::string name; // SSA variable name (e.g., "x_1", "temp_0")
-  std::string type; // Type of the value (e.g., "int", "float", "int*")
-  int version;      // SSA version number
+  ValueId name_id;     // e.g. "x", "temp_0"
+  ValueId type_id;     // e.g. "int", "float", "int*"
+  int version;         // SSA version number
+  ValueId ssa_name_id; // Precomputed "name_version" spelling
 
 public:
+  SSAValue() : name_id(0), type_id(0), version(0), ssa_name_id(0) {}
+
   SSAValue(const std::string &n, const std::string &t, int v = 0)
-      : name(n), type(t), version(v) {}
+      : name_id(IRStringTable::instance().intern(n)),
+        type_id(IRStringTable::instance().intern(t)), version(v),
+        ssa_name_id(IRStringTable::instance().intern(
+            n + "_" + std::to_string(v))) {}
 
-  std::string getName() const { return name; }
-  std::string getType() const { return type; }
+  const std::string &getName() const
+  {
+    return IRStringTable::instance().text(name_id);
+  }
+  const std::string &getType() const
+  {
+    return IRStringTable::instance().text(type_id);
+  }
   int getVersion() const { return version; }
 
   // Returns the full SSA name with version (e.g., "x_1")
-  std::string getSSAName() const
+  const std::string &getSSAName() const
   {
-    return name + "_" + std::to_string(version);
+    return IRStringTable::instance().text(ssa_name_id);
   }
+
+  // Integer identity of name+version; cheap to hash and compare.
+  ValueId getId() const { return ssa_name_id; }
 };
 
 // ============================================================================
 // IR Operand - Represents an operand in an instruction
 // ============================================================================
+// Compact plain-old-data: operand kind, an inline SSAValue (engaged for
+// SSA_VALUE operands) and an interned text id (engaged for constants and
+// labels). No heap allocation, no variant dispatch; copying an operand
+// copies a few words and comparisons are integer compares via getId().
 class IROperand
 {
 public:
@@ -59,16 +120,18 @@ public:
 
 private:
   OperandType opType;
-  std::variant<SSAValue, std::string>
-      value; // SSAValue or constant/label string
+  SSAValue ssaValue; // Valid when opType == SSA_VALUE
+  ValueId text_id;   // Valid when opType == CONSTANT or LABEL
 
 public:
   // Constructor for SSA value
-  IROperand(const SSAValue &val) : opType(OperandType::SSA_VALUE), value(val) {}
+  IROperand(const SSAValue &val)
+      : opType(OperandType::SSA_VALUE), ssaValue(val), text_id(0) {}
 
   // Constructor for constant or label
   IROperand(const std::string &val, OperandType type)
-      : opType(type), value(val) {}
+      : opType(type), ssaValue(),
+        text_id(IRStringTable::instance().intern(val)) {}
 
   OperandType getType() const { return opType; }
 
@@ -76,14 +139,25 @@ public:
   bool isConstant() const { return opType == OperandType::CONSTANT; }
   bool isLabel() const { return opType == OperandType::LABEL; }
 
-  const SSAValue &getSSAValue() const { return std::get<SSAValue>(value); }
+  const SSAValue &getSSAValue() const { return ssaValue; }
 
   const std::string &getConstant() const
   {
-    return std::get<std::string>(value);
+    return IRStringTable::instance().text(text_id);
   }
 
-  const std::string &getLabel() const { return std::get<std::string>(value); }
+  const std::string &getLabel() const
+  {
+    return IRStringTable::instance().text(text_id);
+  }
+
+  // Integer identity of whatever this operand denotes (SSA variable,
+  // constant spelling or label). Two operands of the same kind are equal
+  // iff their ids are equal — the hook for hash-based passes.
+  ValueId getId() const
+  {
+    return isSSAValue() ? ssaValue.getId() : text_id;
+  }
 
   std::string toString() const;
 };
@@ -422,6 +496,8 @@ private:
   std::vector<IRBasicBlock *>
       predecessors;                       // Blocks that can jump to this block
   std::vector<IRBasicBlock *> successors; // Blocks this block can jump to
+  IRBasicBlock *idom = nullptr;           // Immediate dominator (entry: itself)
+  int rpoIndex = -1;                      // Reverse-postorder number (CFG order)
 
 public:
   IRBasicBlock(const std::string &lbl) : label(lbl) {}
@@ -438,10 +514,24 @@ public:
     return instructions;
   }
 
+  // Mutable access for optimization passes
+  std::vector<std::unique_ptr<IRInstruction>> &getInstructions()
+  {
+    return instructions;
+  }
+
   void addPredecessor(IRBasicBlock *block) { predecessors.push_back(block); }
 
   void addSuccessor(IRBasicBlock *block) { successors.push_back(block); }
 
+  void clearEdges()
+  {
+    predecessors.clear();
+    successors.clear();
+    idom = nullptr;
+    rpoIndex = -1;
+  }
+
   const std::vector<IRBasicBlock *> &getPredecessors() const
   {
     return predecessors;
@@ -451,6 +541,12 @@ public:
     return successors;
   }
 
+  // Dominator-tree accessors (valid after IRFunction::computeDominators)
+  IRBasicBlock *getImmediateDominator() const { return idom; }
+  void setImmediateDominator(IRBasicBlock *dom) { idom = dom; }
+  int getRPOIndex() const { return rpoIndex; }
+  void setRPOIndex(int index) { rpoIndex = index; }
+
   std::string toString() const;
 };
 
@@ -489,7 +585,42 @@ public:
     return basicBlocks;
   }
 
+  // ==========================================================================
+  // Control Flow Graph
+  // ==========================================================================
+  // IR generation produces one linear instruction stream; buildCFG() splits
+  // it into genuine basic blocks (a block starts at every LABEL and after
+  // every JUMP/JUMP_IF_FALSE/RETURN), resolves jump targets through a
+  // label->block map built once (no per-jump linear label search), and
+  // wires successor/predecessor edges. Instruction order is preserved, so
+  // emitting the blocks in sequence produces the same program.
+  //
+  // Any pass that inserts or removes control-flow instructions must call
+  // buildCFG() again before relying on the edges.
+  void buildCFG();
+
+  // Compute immediate dominators for all blocks reachable from the entry
+  // (iterative Cooper-Harvey-Kennedy over reverse postorder). Requires a
+  // prior buildCFG(). Entry's idom is itself.
+  void computeDominators();
+
+  // True if `a` dominates `b` (reflexive). Valid after computeDominators().
+  static bool dominates(const IRBasicBlock *a, const IRBasicBlock *b);
+
+  // Entry block (first block), or nullptr for an empty function.
+  IRBasicBlock *getEntryBlock() const
+  {
+    return basicBlocks.empty() ? nullptr : basicBlocks.front().get();
+  }
+
+  // Block starting with the given label, or nullptr. Valid after buildCFG().
+  IRBasicBlock *getBlockForLabel(const std::string &label) const;
+
   std::string toString() const;
+
+private:
+  // label -> block owning that label (rebuilt by buildCFG)
+  std::unordered_map<std::string, IRBasicBlock *> labelToBlock;
 };
 
 // ============================================================================
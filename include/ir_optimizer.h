@@ -2,11 +2,67 @@
 #define IR_OPTIMIZER_H
 
 #include "ir.h"
+#include <functional>
 #include <memory>
 #include <vector>
 #include <unordered_map>
 #include <string>
 
+// ============================================================================
+// Pass Manager - Named passes with per-pass statistics
+// ============================================================================
+// Passes are registered by name and run per-function in registration
+// order. Every run records wall time, the number of transformations the
+// pass reported, and the function's instruction count before and after,
+// so a pathological input can be traced to the pass eating the budget.
+// The accumulated statistics serialize to JSON for the driver's dump
+// plumbing.
+
+struct PassStatistics
+{
+    std::string name;           // Pass name as registered
+    int runs = 0;               // Number of per-function invocations
+    int transformations = 0;    // Total transformations reported
+    long long microseconds = 0; // Total wall time across runs
+    long long instructionsBefore = 0; // Summed instruction count entering the pass
+    long long instructionsAfter = 0;  // Summed instruction count leaving the pass
+};
+
+class PassManager
+{
+public:
+    // A pass runs on one function and returns how many transformations it
+    // performed (instructions folded, eliminated, rewritten, ...).
+    using PassFn = std::function<int(IRFunction*)>;
+
+    // Register a pass under a name; run order is registration order.
+    void registerPass(const std::string& name, PassFn pass);
+
+    // Run every registered pass over the function, recording statistics.
+    void run(IRFunction* function);
+
+    std::vector<PassStatistics> getStatistics() const;
+    void resetStatistics();
+
+    // Fold another manager's statistics into this one (pass-by-pass, by
+    // registration position). Used to merge per-worker results after a
+    // parallel optimization run.
+    void mergeStatistics(const PassManager& other);
+
+    // Serialize the per-pass statistics as a JSON array.
+    std::string statisticsToJson() const;
+
+private:
+    struct RegisteredPass
+    {
+        PassFn fn;
+        PassStatistics stats;
+    };
+    std::vector<RegisteredPass> passes_;
+
+    static long long countInstructions(const IRFunction* function);
+};
+
 // ============================================================================
 // IR Optimizer - Performs optimization passes on SSA IR
 // ============================================================================
@@ -18,10 +74,17 @@
 class IROptimizer
 {
 private:
+    // Named pass pipeline (constant-folding, cse, dce registered in ctor)
+    PassManager passManager_;
+
     // Statistics tracking
     int constantFoldingCount;
     int deadCodeEliminationCount;
     int cseCount;
+    int inliningCount;
+
+    // Fresh-name counter for values created while inlining
+    int inlineNameCounter_ = 0;
 
     // Helper: Check if an operand is a constant
     bool isConstantOperand(const IROperand& operand) const;
@@ -35,9 +98,6 @@ private:
     // Helper: Check if an arithmetic operation can be optimized
     bool canOptimizeArithmetic(const IRInstruction* inst) const;
 
-    // Helper for CSE: Generate a unique key for an expression
-    std::string getExpressionKey(const IRInstruction* inst) const;
-
     // Helper for CSE: Check if instruction is a common subexpression candidate
     bool isCSECandidate(const IRInstruction* inst) const;
 
@@ -67,6 +127,22 @@ public:
     // (Future implementation)
     int commonSubexpressionEliminationPass(IRFunction* function);
 
+    // Loop-Invariant Code Motion: hoist arithmetic whose operands do not
+    // change inside a loop to a preheader block before the loop header
+    // Returns: Number of instructions hoisted
+    int loopInvariantCodeMotionPass(IRFunction* function);
+
+    // Strength reduction: rewrite in-loop multiplies of a basic induction
+    // variable by a constant into an accumulator updated by addition
+    // Returns: Number of multiplies reduced
+    int strengthReductionPass(IRFunction* function);
+
+    // Function inlining: clone small straight-line callee bodies into
+    // their callers before the per-function passes run (whole-module, so
+    // only available from the vector overload of optimize())
+    // Returns: Number of call sites inlined
+    int inlineFunctionsPass(std::vector<std::unique_ptr<IRFunction>>& functions);
+
     // ========================================================================
     // Optimization Pipeline
     // ========================================================================
@@ -86,12 +162,17 @@ public:
     int getConstantFoldingCount() const { return constantFoldingCount; }
     int getDeadCodeEliminationCount() const { return deadCodeEliminationCount; }
     int getCSECount() const { return cseCount; }
+    int getInliningCount() const { return inliningCount; }
 
     // Reset statistics
     void resetStatistics();
 
     // Print optimization report
     void printOptimizationReport() const;
+
+    // Per-pass timing/count statistics gathered by the pass manager
+    const PassManager& getPassManager() const { return passManager_; }
+    PassManager& getPassManager() { return passManager_; }
 };
 
 #endif // IR_OPTIMIZER_H
@@ -56,6 +56,14 @@
  */
 std::string serializeTokensToJson(const std::vector<Token>& tokens);
 
+/**
+ * Serialize tokens to the compact binary stream format ("MTK1"):
+ * fixed-width little-endian records plus one interned string table for
+ * lexemes, filenames and type names. A fraction of the JSON payload's
+ * size and parse cost; decoded by api/utils/token_stream.py.
+ */
+std::string serializeTokensToBinary(const std::vector<Token>& tokens);
+
 // ============================================================================
 // AST Serialization
 // ============================================================================
@@ -78,7 +86,7 @@ std::string serializeTokensToJson(const std::vector<Token>& tokens);
  * - Node-specific fields (e.g., operator for BinaryExpr, name for IdentifierExpr)
  * - Child nodes recursively serialized
  */
-std::string serializeAstToJson(const std::vector<std::unique_ptr<Declaration>>& ast);
+std::string serializeAstToJson(const std::vector<Declaration *>& ast);
 
 // ============================================================================
 // Binary Hex Dump Utility
@@ -105,4 +113,37 @@ std::string serializeAstToJson(const std::vector<std::unique_ptr<Declaration>>&
  */
 std::string generateHexDump(const std::string& executablePath);
 
+// ============================================================================
+// HexDumpView - Lazy windowed hex dump over a memory-mapped binary
+// ============================================================================
+// The frontend only ever displays a small scrolled window of a dump, so
+// formatting a whole multi-megabyte executable up front is wasted work.
+// HexDumpView mmaps the file (via SourceBuffer) and formats exactly the
+// requested byte range on demand, in the same 16-bytes-per-line uppercase
+// format as generateHexDump(). generateHexDump() itself is now a
+// formatRange() over the whole file.
+//
+// Usage:
+//   HexDumpView view;
+//   if (view.open(path)) {
+//       std::string window = view.formatRange(64 * 1024, 4096);
+//   }
+class HexDumpView {
+public:
+    // Map the file; returns false if it cannot be opened or is empty.
+    bool open(const std::string& path);
+
+    // Total size of the mapped file in bytes.
+    size_t size() const;
+
+    // Format `length` bytes starting at `offset` as hex lines. The offset
+    // is aligned down to a 16-byte line boundary and the range is clamped
+    // to the file, so scrolling callers can pass raw positions.
+    std::string formatRange(size_t offset, size_t length) const;
+
+private:
+    // Owning mapping (SourceBuffer handles mmap + read fallback)
+    std::shared_ptr<class SourceBuffer> buffer_;
+};
+
 #endif // JSON_SERIALIZERS_H
@@ -6,7 +6,9 @@
 #include <iostream>
 #include <vector>
 #include <unordered_map>
+#include <cstdint> // For uint64_t in the SWAR scanning kernels
 #include "error_handler.h"
+#include "string_interner.h"
 
 using namespace std; // Avoid in headers if possible
 
@@ -143,12 +145,24 @@ class Lexer
 public:
     // Constructor accepts initial source and filename
     Lexer(const std::string &source, const std::string &initial_filename = "input");
+
+    // Zero-copy constructor: scans `source` in place without taking a heap
+    // copy. The caller (e.g. a SourceBuffer mapping) must keep the buffer
+    // alive for the lexer's lifetime.
+    Lexer(std::string_view source, const std::string &initial_filename);
     Token getNextToken();
     std::vector<Token> lexAll();
 
     // Reset lexer position to beginning (for re-use after lexAll())
     void reset();
 
+    // Access to the identifier interner. Every IDENTIFIER token's value is
+    // the canonical view for its spelling, so downstream consumers
+    // (SymbolTable, IR) can compare interned identifiers by data() pointer
+    // and re-intern their own strings against the same table.
+    StringInterner& getInterner() { return interner_; }
+    const StringInterner& getInterner() const { return interner_; }
+
     // Access to error handler
     ErrorHandler& getErrorHandler() { return error_handler_; }
     const ErrorHandler& getErrorHandler() const { return error_handler_; }
@@ -156,12 +170,13 @@ public:
 
 private:
     // --- Lexer State ---
-    const std::string source_; // Store the source string (not a view)
-    const std::string_view source_view_; // View into the stored source
+    const std::string source_; // Owned copy (empty in zero-copy mode)
+    const std::string_view source_view_; // View into source_ or an external buffer
     size_t current_pos_;
     int current_line_;
     int current_column_;
     std::string current_filename_; // Track current filename
+    StringInterner interner_; // Canonicalizes identifier lexemes
     ErrorHandler error_handler_; // Unified error reporting
     static const int MAX_ERRORS = 100; // Increased for better error recovery
 
@@ -188,22 +203,51 @@ private:
     void skipRestOfLine();
     bool handleLineDirective();
 
+    // --- Bulk Scanning Kernels (SWAR) ---
+    // Character class bits for the 256-entry lookup table. A run scanner
+    // consumes every byte whose class entry has the requested bit set.
+    enum CharClassBit : unsigned char
+    {
+        CC_IDENT_START = 0x01, // [A-Za-z_]
+        CC_IDENT_CHAR = 0x02,  // [A-Za-z0-9_]
+        CC_DIGIT = 0x04,       // [0-9]
+        CC_HEX_DIGIT = 0x08,   // [0-9A-Fa-f]
+        CC_WS = 0x10           // space, tab, carriage return (not newline)
+    };
+    static const unsigned char kCharClass[256];
+
+    // Length of the run starting at `pos` whose bytes all match `mask`.
+    // Processes the source 8 bytes at a time; never crosses a newline
+    // because '\n' carries no class bit.
+    size_t runLength(size_t pos, unsigned char mask) const;
+
+    // Advance over `n` bytes known to contain no newline (column-only update).
+    inline void advanceBy(size_t n)
+    {
+        current_pos_ += n;
+        current_column_ += static_cast<int>(n);
+    }
+
+    // Advance to absolute position `pos`, counting newlines in between.
+    // Used after memchr-style skips over comment/line bodies.
+    void advanceTo(size_t pos);
+
     // --- Character Classification (Optimized) ---
     static inline bool is_identifier_start(char c)
     {
-        return std::isalpha(c) || c == '_';
+        return kCharClass[static_cast<unsigned char>(c)] & CC_IDENT_START;
     }
     static inline bool is_identifier_char(char c)
     {
-        return std::isalnum(c) || c == '_';
+        return kCharClass[static_cast<unsigned char>(c)] & CC_IDENT_CHAR;
     }
     static inline bool is_digit(char c)
     {
-        return std::isdigit(c);
+        return kCharClass[static_cast<unsigned char>(c)] & CC_DIGIT;
     }
     static inline bool is_hex_digit(char c)
     {
-        return std::isxdigit(c);
+        return kCharClass[static_cast<unsigned char>(c)] & CC_HEX_DIGIT;
     }
 
     // --- Token Scanning Functions ---
@@ -214,11 +258,9 @@ private:
     Token scanOperator(int start_line, int start_column);
     Token scanDelimiter(int start_line, int start_column);
 
-    // Update checkKeyword to accept string_view
+    // Classify a lexeme as one of the 32 C89 keywords or IDENTIFIER.
+    // Length-bucketed switch table; no hashing, no allocation.
     TokenType checkKeyword(std::string_view value) const;
-
-    // C keyword lookup table
-    static const std::unordered_map<std::string, TokenType> keywords_;
 };
 
 #endif // LEXER_H
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define PARSER_H
 
 #include "ast.h"
+#include "ast_arena.h"
 #include "error_handler.h"
 #include "lexer.h"
 #include <memory>
@@ -16,33 +17,37 @@ public:
   Parser(Lexer &lexer);
 
   // Main parsing methods
-  std::unique_ptr<Expression> parseExpression();
-  std::unique_ptr<Expression> parsePrimaryExpression();
-  std::unique_ptr<Expression> parseUnaryExpression();
-  std::unique_ptr<Expression> parseBinaryExpression(int min_precedence = 0);
+  Expression *parseExpression();
+  Expression *parsePrimaryExpression();
+  Expression *parseUnaryExpression();
+  Expression *parseBinaryExpression(int min_precedence = 0);
 
   // Specific expression parsers
-  std::unique_ptr<Expression> parseIdentifier();
-  std::unique_ptr<Expression> parseLiteral();
-  std::unique_ptr<Expression> parseParenthesizedExpression();
+  Expression *parseIdentifier();
+  Expression *parseLiteral();
+  Expression *parseParenthesizedExpression();
 
   // Statement parsing
-  std::unique_ptr<Statement> parseStatement();
-  std::unique_ptr<Statement> parseIfStatement();
-  std::unique_ptr<Statement> parseWhileStatement();
-  std::unique_ptr<Statement> parseForStatement();
-  std::unique_ptr<Statement> parseReturnStatement();
-  std::unique_ptr<Statement> parseExpressionStatement();
-  std::unique_ptr<Statement> parseCompoundStatement();
+  Statement *parseStatement();
+  Statement *parseIfStatement();
+  Statement *parseWhileStatement();
+  Statement *parseForStatement();
+  Statement *parseReturnStatement();
+  Statement *parseExpressionStatement();
+  Statement *parseCompoundStatement();
 
   // Program parsing (top-level entry point)
-  std::vector<std::unique_ptr<Declaration>> parseProgram();
+  std::vector<Declaration *> parseProgram();
 
   // Declaration parsing
-  std::unique_ptr<Declaration> parseDeclaration();
-  std::unique_ptr<Declaration> parseVariableDeclaration();
-  std::unique_ptr<Declaration> parseFunctionDeclaration();
-  std::unique_ptr<Declaration> parseStructDefinition(); // USER STORY #19
+  Declaration *parseDeclaration();
+  Declaration *parseVariableDeclaration();
+  Declaration *parseFunctionDeclaration();
+  Declaration *parseStructDefinition(); // USER STORY #19
+
+  // Arena owning every node this parser creates. The returned raw AST
+  // pointers stay valid as long as the Parser (and thus the arena) lives.
+  ASTArena &getArena() { return arena_; }
 
   // Error handling public API
   ErrorHandler &getErrorHandler() { return error_handler_; }
@@ -52,6 +57,7 @@ public:
 private:
   Lexer &lexer_;
   Token current_token_;
+  ASTArena arena_;             // Bump-allocates all AST nodes
   ErrorHandler error_handler_; // Unified error reporting
 
   // Token management
@@ -75,20 +81,20 @@ private:
   // Helper methods
   bool isTypeKeyword(TokenType type) const;
   std::string parseType();
-  std::vector<std::unique_ptr<ParameterDecl>> parseParameterList();
+  std::vector<ParameterDecl *> parseParameterList();
 
   // Declaration parsing helpers (refactored for clarity)
-  std::unique_ptr<Declaration> parseStructDeclarationOrDefinition();
-  std::vector<std::unique_ptr<VarDecl>> parseStructFieldList();
-  std::unique_ptr<Declaration>
+  Declaration *parseStructDeclarationOrDefinition();
+  std::vector<VarDecl *> parseStructFieldList();
+  Declaration *
   parseFunctionDeclarationImpl(const Token &start_token,
                                const std::string &type, const std::string &name,
                                int pointerLevel, bool isExtern = false);
-  std::unique_ptr<Declaration> parseArrayDeclaration(const Token &start_token,
+  Declaration *parseArrayDeclaration(const Token &start_token,
                                                      const std::string &type,
                                                      const std::string &name,
                                                      int pointerLevel);
-  std::unique_ptr<Declaration>
+  Declaration *
   parseVariableDeclarationImpl(const Token &start_token,
                                const std::string &type, const std::string &name,
                                int pointerLevel);
@@ -2,28 +2,59 @@
 #define SCOPE_MANAGER_H
 
 #include "symbol_table.h"
+#include <cstdint>
 #include <vector>
 #include <optional>
 
-// ScopeManager manages a stack of symbol tables for nested scopes
-// Supports variable shadowing and hierarchical symbol lookup
+// ScopeManager manages symbol bindings for nested scopes.
+// Supports variable shadowing and hierarchical symbol lookup.
+//
+// Internally this is no longer a stack of per-scope hash maps. All
+// bindings live in one contiguous store (a stack of entries), an
+// open-addressing index keyed by dense interned name IDs maps each name to
+// its newest binding, and shadowed bindings are linked through the entries
+// themselves. Entering a scope just records a watermark; exiting truncates
+// the store back to it and restores the shadowed slots. A name costs one
+// string hash to resolve to its ID; everything after that is integer
+// probing, regardless of scope depth.
 class ScopeManager {
 private:
-    // Stack of symbol tables, one per scope level
-    // Index 0 is the global scope, higher indices are nested scopes
-    std::vector<SymbolTable> scope_stack_;
-
-    // Current scope level (0 = global, 1+ = nested)
+    // One binding in the contiguous store.
+    struct StoredSymbol {
+        Symbol symbol;
+        uint32_t name_id;        // Dense interned ID of symbol.name
+        uint32_t prev_binding;   // Index+1 of the binding this one shadows (0 = none)
+    };
+
+    std::vector<StoredSymbol> store_;   // All live bindings, in insertion order
+    std::vector<uint32_t> slots_;       // Open-addressing index: name_id -> store index+1
+    std::vector<size_t> scope_marks_;   // Watermark (store_ size) at each scope entry
     int current_scope_level_;
 
+    // Name interning: full string hash happens exactly once per query;
+    // after that names are compared and probed as integers.
+    std::unordered_map<std::string, uint32_t> name_ids_;
+    std::vector<const std::string*> id_names_;  // Dense ID -> canonical name
+
+    // Intern helpers. The const variant returns UINT32_MAX for names that
+    // were never seen (cheap negative lookups).
+    uint32_t intern_name(const std::string& name);
+    uint32_t find_name_id(const std::string& name) const;
+
+    // Open-addressing index operations (linear probing, power-of-two size)
+    size_t probe_slot(uint32_t name_id) const;  // Slot holding name_id, or empty slot
+    void grow_slots();
+    uint32_t newest_binding(const std::string& name) const;  // store index+1, 0 = none
+
 public:
     // Constructor - automatically creates global scope
     ScopeManager();
 
-    // Enter a new scope (push a new symbol table onto the stack)
+    // Enter a new scope (record a watermark over the binding store)
     void enter_scope();
 
-    // Exit the current scope (pop the top symbol table)
+    // Exit the current scope (truncate the store back to the watermark,
+    // restoring any shadowed bindings)
     // Returns false if attempting to pop global scope, true otherwise
     bool exit_scope();
 
@@ -31,7 +62,7 @@ public:
     // Returns true if inserted, false if symbol already exists in current scope
     bool insert(const Symbol& symbol);
 
-    // Lookup a symbol by name, searching from innermost to outermost scope
+    // Lookup a symbol by name; shadowing means the newest binding wins
     // Returns the first matching symbol found, or std::nullopt if not found
     std::optional<Symbol> lookup(const std::string& name) const;
 
@@ -45,7 +76,7 @@ public:
     int get_current_scope_level() const { return current_scope_level_; }
 
     // Get the number of active scopes (always >= 1 because of global scope)
-    size_t get_scope_count() const { return scope_stack_.size(); }
+    size_t get_scope_count() const { return scope_marks_.size(); }
 
     // Check if currently in global scope
     bool is_global_scope() const { return current_scope_level_ == 0; }
@@ -62,7 +93,7 @@ public:
     // Get all symbol names from all scopes (for suggestions)
     std::vector<std::string> get_all_symbol_names() const;
 
-    // Mark a symbol as used (searches all scopes from innermost to outermost)
+    // Mark a symbol as used (innermost binding wins)
     void mark_symbol_as_used(const std::string& name);
 
     // Get all unused variables from the current scope
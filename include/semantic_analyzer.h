@@ -2,6 +2,7 @@
 #define SEMANTIC_ANALYZER_H
 
 #include "ast.h"
+#include "ast_arena.h"
 #include "error_handler.h"
 #include "scope_manager.h"
 #include "type.h"
@@ -20,6 +21,7 @@
 class SemanticAnalyzer : public ASTVisitor {
 private:
   ScopeManager scope_manager_;
+  ASTArena *arena_;            // Arena for implicit-conversion nodes (not owned)
   ErrorHandler error_handler_; // Unified error reporting
   bool in_function_scope_;     // Track if we're currently inside a function
   bool warnings_enabled_;      // Control whether warnings are emitted
@@ -85,9 +87,13 @@ private:
 public:
   SemanticAnalyzer();
 
+  // Set the arena used to allocate implicit TypeCastExpr nodes. Must be
+  // the arena that owns the tree being analyzed (Parser::getArena()), so
+  // inserted nodes share the AST's lifetime.
+  void set_arena(ASTArena *arena) { arena_ = arena; }
+
   // Analyze a program (list of declarations)
-  void analyze_program(
-      const std::vector<std::unique_ptr<Declaration>> &declarations);
+  void analyze_program(const std::vector<Declaration *> &declarations);
 
   // Access to error handler
   ErrorHandler &getErrorHandler() { return error_handler_; }
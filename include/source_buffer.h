@@ -0,0 +1,57 @@
+#ifndef SOURCE_BUFFER_H
+#define SOURCE_BUFFER_H
+
+#include <string>
+#include <string_view>
+
+// ============================================================================
+// SourceBuffer - Memory-mapped source file access
+// ============================================================================
+// Maps a source file read-only into the address space so the lexer's
+// string_view-based scanning can run directly over the page cache: no heap
+// copy of the file contents and no read() of bytes that are never touched.
+// Falls back to an ordinary buffered read when mmap is unavailable (empty
+// files, pipes, Windows), so callers never need to care which path was used.
+//
+// Usage:
+//   SourceBuffer buffer;
+//   if (!buffer.loadFile(path)) {
+//       std::cerr << buffer.getError() << std::endl;
+//   }
+//   Lexer lexer(buffer.view(), path);   // Buffer must outlive the lexer
+class SourceBuffer
+{
+public:
+    SourceBuffer() = default;
+    ~SourceBuffer();
+
+    // Non-copyable: views handed out point at the mapping.
+    SourceBuffer(const SourceBuffer &) = delete;
+    SourceBuffer &operator=(const SourceBuffer &) = delete;
+
+    // Map (or read) the file at `path`. Returns false on failure, in which
+    // case getError() describes what went wrong. Any previously loaded
+    // contents are released first.
+    bool loadFile(const std::string &path);
+
+    // View of the file contents. Valid until the buffer is destroyed or
+    // loadFile() is called again.
+    std::string_view view() const { return view_; }
+
+    size_t size() const { return view_.size(); }
+    bool isLoaded() const { return loaded_; }
+    bool isMapped() const { return mapped_data_ != nullptr; }
+    const std::string &getError() const { return error_; }
+
+private:
+    void release();
+
+    std::string_view view_;    // Contents (mapping or fallback buffer)
+    void *mapped_data_ = nullptr; // mmap base address (nullptr = not mapped)
+    size_t mapped_size_ = 0;   // Length passed to munmap
+    std::string fallback_;     // Owning storage for the non-mmap path
+    bool loaded_ = false;
+    std::string error_;        // Description of the last failure
+};
+
+#endif // SOURCE_BUFFER_H
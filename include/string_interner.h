@@ -0,0 +1,39 @@
+#ifndef STRING_INTERNER_H
+#define STRING_INTERNER_H
+
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <deque>
+
+// Deduplicates strings so every distinct spelling is stored exactly once.
+// intern() returns a canonical string_view whose data() pointer is stable
+// for the interner's lifetime, so two interned views are equal iff their
+// data() pointers are equal. This lets SymbolTable and the IR compare
+// identifiers by identity instead of character-by-character, and keeps
+// tokens valid even after the original source buffer goes away.
+class StringInterner
+{
+public:
+    StringInterner() = default;
+
+    // Non-copyable: handed-out views point into our storage.
+    StringInterner(const StringInterner &) = delete;
+    StringInterner &operator=(const StringInterner &) = delete;
+
+    // Return the canonical view for `s`, inserting a copy on first sight.
+    // Lookup on a hit performs no allocation.
+    std::string_view intern(std::string_view s);
+
+    // Number of distinct strings interned so far.
+    size_t size() const { return index_.size(); }
+
+private:
+    // Owning storage. std::deque never relocates existing elements, so
+    // views into storage_ stay valid as the table grows.
+    std::deque<std::string> storage_;
+    // Lookup index of views into storage_ (no second copy of the bytes).
+    std::unordered_set<std::string_view> index_;
+};
+
+#endif // STRING_INTERNER_H
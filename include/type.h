@@ -1,7 +1,9 @@
 #ifndef TYPE_H
 #define TYPE_H
 
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -9,6 +11,34 @@
 // Forward declaration for struct member types
 class Type;
 
+// ============================================================================
+// TypeContext - Uniques scalar/pointer/array types
+// ============================================================================
+// Every distinct (base type, pointer depth, array-ness, array size)
+// combination exists exactly once; asking for "pointer to int" twice
+// returns the same shared_ptr, so equality of non-struct types is a
+// pointer comparison and expression-heavy type checking stops allocating
+// temporary Types. The static Type factories and Type::fromString all
+// route through here. Struct types are not uniqued by the context — the
+// semantic analyzer's struct registry already holds one Type per struct
+// name. Process-wide and mutex-guarded for the parallel pipelines.
+class TypeContext {
+public:
+  static TypeContext &instance();
+
+  // Canonical type for the given shape (scalar, pointer or array)
+  std::shared_ptr<Type> get(int base, int pointer_depth = 0,
+                            bool is_array = false, int array_size = 0);
+
+private:
+  TypeContext() = default;
+  TypeContext(const TypeContext &) = delete;
+  TypeContext &operator=(const TypeContext &) = delete;
+
+  std::mutex mutex_;
+  std::unordered_map<uint64_t, std::shared_ptr<Type>> types_;
+};
+
 /**
  * @brief Represents types in the C type system
  *
@@ -119,19 +119,26 @@ LinearScanAllocator::LinearScanAllocator() : nextSpillSlot(0)
   // (A production compiler would also use callee-saved with proper
   // save/restore)
 
+  // %r10/%r11 are reserved: the emitters clobber them as raw scratch
+  // (spilled destinations, the division save/restore shuffle, load/store
+  // staging), so no allocated value may live there. The graph-coloring
+  // mode excludes them for the same reason.
   availableRegisters = {X86Register::RAX, X86Register::RCX, X86Register::RDX,
                         X86Register::RSI, X86Register::RDI, X86Register::R8,
-                        X86Register::R9, X86Register::R10, X86Register::R11};
+                        X86Register::R9};
 }
 
 void LinearScanAllocator::buildLiveIntervals(IRFunction *function)
 {
   intervals.clear();
+  valueToInterval.clear();
+  registerAssignments.clear();
+  movePairs.clear();
   nextSpillSlot = 0;
 
-  // Map SSA names to their live intervals (use names since operands contain
-  // copies)
-  std::unordered_map<std::string, int> nameToInterval;
+  // Map SSA ids to their live intervals (integer keys, no string hashing)
+  std::unordered_map<ValueId, int> idToInterval;
+  std::vector<int> callPositions; // For crossesCall marking below
 
   int instructionIndex = 0;
 
@@ -140,39 +147,56 @@ void LinearScanAllocator::buildLiveIntervals(IRFunction *function)
   {
     for (const auto &inst : block->getInstructions())
     {
+      if (inst->getOpcode() == IROpcode::CALL)
+      {
+        callPositions.push_back(instructionIndex);
+      }
+
       // If instruction defines a result, start a new interval
       if (inst->getResult() != nullptr)
       {
         SSAValue *result = inst->getResult();
-        std::string ssaName = result->getSSAName();
+        ValueId id = result->getId();
 
         // Check if interval already exists
-        auto it = nameToInterval.find(ssaName);
-        if (it == nameToInterval.end())
+        auto it = idToInterval.find(id);
+        if (it == idToInterval.end())
         {
           // Create new interval
           intervals.emplace_back(result, instructionIndex, instructionIndex);
-          nameToInterval[ssaName] = intervals.size() - 1;
+          intervals.back().usePositions.push_back(instructionIndex);
+          idToInterval[id] = intervals.size() - 1;
         }
         else
         {
           // Extend existing interval
           intervals[it->second].end = instructionIndex;
+          intervals[it->second].useCount++;
+          intervals[it->second].usePositions.push_back(instructionIndex);
         }
       }
 
+      // Move-related pair: the graph allocator tries to give both sides
+      // one color so the copy becomes a removable self-move
+      if (inst->getOpcode() == IROpcode::MOVE && inst->getResult() != nullptr &&
+          !inst->getOperands().empty() && inst->getOperands()[0].isSSAValue())
+      {
+        movePairs.push_back({inst->getResult()->getId(),
+                             inst->getOperands()[0].getSSAValue().getId()});
+      }
+
       // For all operands used, extend their intervals
       for (const auto &operand : inst->getOperands())
       {
         if (operand.isSSAValue())
         {
-          const SSAValue &value = operand.getSSAValue();
-          std::string ssaName = value.getSSAName();
-          auto it = nameToInterval.find(ssaName);
-          if (it != nameToInterval.end())
+          auto it = idToInterval.find(operand.getSSAValue().getId());
+          if (it != idToInterval.end())
           {
             // Extend interval to this use
             intervals[it->second].end = instructionIndex;
+            intervals[it->second].useCount++;
+            intervals[it->second].usePositions.push_back(instructionIndex);
           }
         }
       }
@@ -181,8 +205,97 @@ void LinearScanAllocator::buildLiveIntervals(IRFunction *function)
     }
   }
 
+  // Extend intervals across loop back edges: a value defined before a
+  // loop and used inside it is live on *every* iteration, so its interval
+  // must reach the back-edge jump even when its last use sits earlier in
+  // the linear order — otherwise the register gets reused mid-loop and
+  // clobbers the value for the next iteration.
+  {
+    std::unordered_map<std::string, int> labelPositions;
+    std::vector<std::pair<int, int>> backEdges; // (label pos, jump pos)
+    int index = 0;
+    for (const auto &block : function->getBasicBlocks())
+    {
+      for (const auto &inst : block->getInstructions())
+      {
+        if (inst->getOpcode() == IROpcode::LABEL)
+        {
+          labelPositions[static_cast<const LabelInst *>(inst.get())
+                             ->getLabelName()] = index;
+        }
+        else if (inst->getOpcode() == IROpcode::JUMP ||
+                 inst->getOpcode() == IROpcode::JUMP_IF_FALSE)
+        {
+          const std::string &target =
+              (inst->getOpcode() == IROpcode::JUMP)
+                  ? static_cast<const JumpInst *>(inst.get())->getTargetLabel()
+                  : static_cast<const JumpIfFalseInst *>(inst.get())
+                        ->getTargetLabel();
+          auto it = labelPositions.find(target);
+          if (it != labelPositions.end() && it->second < index)
+          {
+            backEdges.push_back({it->second, index});
+          }
+        }
+        index++;
+      }
+    }
+    for (auto &interval : intervals)
+    {
+      for (const auto &edge : backEdges)
+      {
+        if (interval.start < edge.first && interval.end >= edge.first &&
+            interval.end < edge.second)
+        {
+          interval.end = edge.second;
+        }
+      }
+    }
+
+    // Weight each use by its loop depth (x4 per enclosing loop, capped):
+    // spilling a value that is touched every iteration costs far more
+    // than spilling one used the same number of times in straight code.
+    for (auto &interval : intervals)
+    {
+      double weighted = 0.0;
+      for (int pos : interval.usePositions)
+      {
+        double factor = 1.0;
+        for (const auto &edge : backEdges)
+        {
+          if (edge.first <= pos && pos <= edge.second && factor < 64.0)
+          {
+            factor *= 4.0;
+          }
+        }
+        weighted += factor;
+      }
+      interval.weightedUseCount = weighted > 0.0 ? weighted : 1.0;
+    }
+  }
+
+  // Mark intervals that stay live across a call (their register would
+  // need saving at every one of those call sites)
+  for (auto &interval : intervals)
+  {
+    for (int callPos : callPositions)
+    {
+      if (interval.start < callPos && callPos < interval.end)
+      {
+        interval.crossesCall = true;
+        break;
+      }
+    }
+  }
+
   // Sort intervals by start point (required for linear scan)
   std::sort(intervals.begin(), intervals.end());
+
+  // Index by value id after the sort settles positions
+  for (size_t i = 0; i < intervals.size(); ++i)
+  {
+    valueToInterval[intervals[i].value->getId()] = i;
+  }
 }
 
 void LinearScanAllocator::expireOldIntervals(LiveInterval *current)
@@ -228,6 +341,7 @@ bool LinearScanAllocator::allocateFreeRegister(LiveInterval *interval)
   availableRegisters.pop_back();
 
   interval->assignedReg = reg;
+  registerAssignments[reg].push_back(interval);
   return true;
 }
 
@@ -238,8 +352,169 @@ void LinearScanAllocator::spillInterval(LiveInterval *interval)
   interval->assignedReg = X86Register::NONE;
 }
 
+// ============================================================================
+// Graph-coloring allocation (Chaitin-Briggs style)
+// ============================================================================
+// Nodes are live intervals, edges are lifetime overlaps, colors are the
+// same nine caller-saved registers the linear path uses. Simplify pushes
+// low-degree nodes; blocked graphs push the cheapest (lowest spill
+// weight) node optimistically. Select colors in reverse, preferring the
+// color of a move partner when it is available so mov-related values
+// coalesce; colorless nodes spill and the shared second-chance/slot
+// coalescing machinery cleans up afterwards.
+void LinearScanAllocator::allocateGraphColoring()
+{
+  // %r10/%r11 are excluded: the emitters clobber them as raw scratch
+  // (spilled destinations, division save/restore, load/store staging),
+  // and unlike linear scan's short greedy lifetimes, graph coloring
+  // happily parks long-lived values there.
+  static const X86Register kColors[] = {
+      X86Register::RAX, X86Register::RCX, X86Register::RDX,
+      X86Register::RSI, X86Register::RDI, X86Register::R8,
+      X86Register::R9};
+  const int K = static_cast<int>(sizeof(kColors) / sizeof(kColors[0]));
+  const size_t n = intervals.size();
+
+  // Interference graph from interval overlaps (sorted by start, so the
+  // inner scan stops at the first non-overlapping start)
+  std::vector<std::vector<int>> adjacency(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    for (size_t j = i + 1; j < n; ++j)
+    {
+      if (intervals[j].start > intervals[i].end)
+      {
+        break;
+      }
+      adjacency[i].push_back(static_cast<int>(j));
+      adjacency[j].push_back(static_cast<int>(i));
+    }
+  }
+
+  // Simplify: build the select stack
+  std::vector<int> degree(n);
+  std::vector<bool> removed(n, false);
+  for (size_t i = 0; i < n; ++i)
+  {
+    degree[i] = static_cast<int>(adjacency[i].size());
+  }
+  std::vector<int> selectStack;
+  selectStack.reserve(n);
+  for (size_t iteration = 0; iteration < n; ++iteration)
+  {
+    int picked = -1;
+    // Prefer a trivially colorable node...
+    for (size_t i = 0; i < n; ++i)
+    {
+      if (!removed[i] && degree[i] < K)
+      {
+        picked = static_cast<int>(i);
+        break;
+      }
+    }
+    // ...otherwise push the cheapest node as a potential spill
+    if (picked == -1)
+    {
+      double bestWeight = 0.0;
+      for (size_t i = 0; i < n; ++i)
+      {
+        if (!removed[i] &&
+            (picked == -1 || intervals[i].spillWeight() < bestWeight))
+        {
+          picked = static_cast<int>(i);
+          bestWeight = intervals[i].spillWeight();
+        }
+      }
+    }
+    removed[picked] = true;
+    selectStack.push_back(picked);
+    for (int neighbor : adjacency[picked])
+    {
+      degree[neighbor]--;
+    }
+  }
+
+  // Move-affinity lookup by value id
+  std::unordered_map<ValueId, std::vector<ValueId>> affinity;
+  for (const auto &pair : movePairs)
+  {
+    affinity[pair.first].push_back(pair.second);
+    affinity[pair.second].push_back(pair.first);
+  }
+
+  // Select: color in reverse removal order
+  std::vector<int> color(n, -1);
+  for (auto it = selectStack.rbegin(); it != selectStack.rend(); ++it)
+  {
+    int node = *it;
+    bool used[16] = {false};
+    for (int neighbor : adjacency[node])
+    {
+      if (color[neighbor] >= 0)
+      {
+        used[color[neighbor]] = true;
+      }
+    }
+
+    int chosen = -1;
+    // Prefer a move partner's color when free (coalescing by preference)
+    auto affinityIt = affinity.find(intervals[node].value->getId());
+    if (affinityIt != affinity.end())
+    {
+      for (ValueId partner : affinityIt->second)
+      {
+        auto partnerIt = valueToInterval.find(partner);
+        if (partnerIt == valueToInterval.end())
+        {
+          continue;
+        }
+        int partnerColor = color[partnerIt->second];
+        if (partnerColor >= 0 && !used[partnerColor])
+        {
+          chosen = partnerColor;
+          break;
+        }
+      }
+    }
+    if (chosen == -1)
+    {
+      for (int c = 0; c < K; ++c)
+      {
+        if (!used[c])
+        {
+          chosen = c;
+          break;
+        }
+      }
+    }
+
+    if (chosen == -1)
+    {
+      spillInterval(&intervals[node]); // Optimistic coloring failed
+    }
+    else
+    {
+      color[node] = chosen;
+      intervals[node].assignedReg = kColors[chosen];
+      registerAssignments[kColors[chosen]].push_back(&intervals[node]);
+    }
+  }
+
+  // Shared cleanup: rescue spills into holes, coalesce slots
+  secondChancePass();
+}
+
 void LinearScanAllocator::allocate()
 {
+  // Release-quality mode: color the interference graph instead of
+  // scanning, unless the function is huge (the O(n^2) graph build would
+  // dominate; linear scan handles those)
+  if (mode_ == Mode::GRAPH_COLORING && intervals.size() <= 2000)
+  {
+    allocateGraphColoring();
+    return;
+  }
+
   active.clear();
 
   for (auto &interval : intervals)
@@ -256,22 +531,25 @@ void LinearScanAllocator::allocate()
     else
     {
       // No free registers, must spill
-      // Strategy: Spill the interval that ends last (farthest use)
+      // Strategy: Spill the cheapest interval by use density (uses per
+      // instruction of lifetime, discounted for call crossings), choosing
+      // among the active intervals and the current one. Hot loop values
+      // have high density and keep their registers.
 
-      // Find interval in active with latest end
-      auto spillCandidate = std::max_element(
+      auto spillCandidate = std::min_element(
           active.begin(), active.end(),
           [](LiveInterval *a, LiveInterval *b)
-          { return a->end < b->end; });
+          { return a->spillWeight() < b->spillWeight(); });
 
       if (spillCandidate != active.end() &&
-          (*spillCandidate)->end > interval.end)
+          (*spillCandidate)->spillWeight() < interval.spillWeight())
       {
         // Spill the candidate and use its register for current interval
         X86Register reg = (*spillCandidate)->assignedReg;
         spillInterval(*spillCandidate);
 
         interval.assignedReg = reg;
+        registerAssignments[reg].push_back(&interval);
 
         // Replace spilled interval with current in active list
         *spillCandidate = &interval;
@@ -283,48 +561,106 @@ void LinearScanAllocator::allocate()
       }
     }
   }
+
+  // Second chance: binpack spilled intervals into lifetime holes
+  secondChancePass();
 }
 
-X86Register LinearScanAllocator::getRegister(const SSAValue *value) const
+// Try to rescue spilled intervals by packing them into lifetime holes of
+// registers the main scan already used: a register whose assigned
+// intervals all avoid the spilled interval's range can simply hold it.
+// Rescued intervals consume no spill slot and produce no stack traffic.
+void LinearScanAllocator::secondChancePass()
 {
-  // Compare by SSA name since operands contain copies, not original pointers
-  std::string targetName = value->getSSAName();
-  for (const auto &interval : intervals)
+  for (auto &interval : intervals)
   {
-    if (interval.value->getSSAName() == targetName)
+    if (interval.spillSlot == -1)
     {
-      return interval.assignedReg;
+      continue; // Already in a register
+    }
+
+    for (auto &entry : registerAssignments)
+    {
+      // Never park a rescued value in %r10 or %r11: the emitters use
+      // them as raw scratch (spilled destinations, the division
+      // save/restore shuffle, load/store address staging), so a value
+      // living in a "hole" there is silently clobbered by any such
+      // instruction inside the hole.
+      if (entry.first == X86Register::R10 || entry.first == X86Register::R11)
+      {
+        continue;
+      }
+      bool fits = true;
+      for (const LiveInterval *assigned : entry.second)
+      {
+        if (assigned->overlaps(interval))
+        {
+          fits = false;
+          break;
+        }
+      }
+      if (fits)
+      {
+        interval.assignedReg = entry.first;
+        interval.spillSlot = -1;
+        entry.second.push_back(&interval);
+        break;
+      }
     }
   }
-  return X86Register::NONE;
-}
 
-bool LinearScanAllocator::isSpilled(const SSAValue *value) const
-{
-  // Compare by SSA name since operands contain copies, not original pointers
-  std::string targetName = value->getSSAName();
-  for (const auto &interval : intervals)
+  // Coalesce spill slots: non-overlapping spilled intervals can share a
+  // stack slot. Intervals are already sorted by start, so a greedy scan
+  // placing each one into the first slot that is free by its start point
+  // yields minimal-height frames (interval-graph coloring).
+  nextSpillSlot = 0;
+  std::vector<int> slotLastEnd; // Per slot: end of the latest occupant
+  for (auto &interval : intervals)
   {
-    if (interval.value->getSSAName() == targetName)
+    if (interval.spillSlot == -1)
+    {
+      continue;
+    }
+    int chosen = -1;
+    for (size_t slot = 0; slot < slotLastEnd.size(); ++slot)
+    {
+      if (slotLastEnd[slot] < interval.start)
+      {
+        chosen = static_cast<int>(slot);
+        break;
+      }
+    }
+    if (chosen == -1)
     {
-      return interval.spillSlot != -1;
+      chosen = nextSpillSlot++;
+      slotLastEnd.push_back(interval.end);
     }
+    else
+    {
+      slotLastEnd[chosen] = interval.end;
+    }
+    interval.spillSlot = chosen;
   }
-  return false;
+}
+
+X86Register LinearScanAllocator::getRegister(const SSAValue *value) const
+{
+  // Operands hold copies, so match on the interned value id
+  auto it = valueToInterval.find(value->getId());
+  return (it != valueToInterval.end()) ? intervals[it->second].assignedReg
+                                       : X86Register::NONE;
+}
+
+bool LinearScanAllocator::isSpilled(const SSAValue *value) const
+{
+  auto it = valueToInterval.find(value->getId());
+  return it != valueToInterval.end() && intervals[it->second].spillSlot != -1;
 }
 
 int LinearScanAllocator::getSpillSlot(const SSAValue *value) const
 {
-  // Compare by SSA name since operands contain copies, not original pointers
-  std::string targetName = value->getSSAName();
-  for (const auto &interval : intervals)
-  {
-    if (interval.value->getSSAName() == targetName)
-    {
-      return interval.spillSlot;
-    }
-  }
-  return -1;
+  auto it = valueToInterval.find(value->getId());
+  return (it != valueToInterval.end()) ? intervals[it->second].spillSlot : -1;
 }
 
 void LinearScanAllocator::printAllocation() const
@@ -353,281 +689,508 @@ void LinearScanAllocator::printAllocation() const
 // Peephole Optimizer - Implementation
 // ============================================================================
 
-PeepholeOptimizer::PeepholeOptimizer() : optimizationEnabled(true) {}
-
-void PeepholeOptimizer::reset() { instructions.clear(); }
-
-void PeepholeOptimizer::addInstruction(const std::string &inst)
-{
-  instructions.push_back(inst);
-}
+// ============================================================================
+// MachineInstr rendering
+// ============================================================================
 
-bool PeepholeOptimizer::isRedundantMove(const std::string &inst) const
+std::string MachineInstr::render() const
 {
-  // Pattern: movq %rax, %rax (moving register to itself)
-  // Instructions may have leading whitespace
-  std::string trimmed = inst;
-  trimmed.erase(0, trimmed.find_first_not_of(" \t"));
-
-  if (trimmed.find("movq ") != 0 && trimmed.find("movl ") != 0 &&
-      trimmed.find("movw ") != 0 && trimmed.find("movb ") != 0)
+  if (!modified)
   {
-    return false;
+    return raw; // Untouched lines reproduce the original text exactly
   }
+  std::ostringstream out;
+  out << "    " << opcode;
+  for (size_t i = 0; i < operands.size(); ++i)
+  {
+    out << (i == 0 ? " " : ", ") << operands[i].text;
+  }
+  out << "\n";
+  return out.str();
+}
 
-  // Extract source and destination
-  size_t commaPos = trimmed.find(',');
-  if (commaPos == std::string::npos)
-    return false;
-
-  size_t firstSpace = trimmed.find(' ');
-  std::string src = trimmed.substr(firstSpace + 1, commaPos - firstSpace - 1);
-  std::string dst = trimmed.substr(commaPos + 1); // Skip ","
+// ============================================================================
+// Peephole Optimizer
+// ============================================================================
 
-  // Trim whitespace
-  src.erase(0, src.find_first_not_of(" \t"));
-  src.erase(src.find_last_not_of(" \t\n\r") + 1);
-  dst.erase(0, dst.find_first_not_of(" \t"));
-  dst.erase(dst.find_last_not_of(" \t\n\r") + 1);
+PeepholeOptimizer::PeepholeOptimizer() : optimizationEnabled(true) {}
 
-  return src == dst;
-}
+void PeepholeOptimizer::reset() { instructions.clear(); }
 
-bool PeepholeOptimizer::isArithmeticWithZero(const std::string &inst) const
+MachineOperand PeepholeOptimizer::parseOperand(const std::string &text)
 {
-  // Pattern: addq $0, %rax or subq $0, %rax
-  std::string trimmed = inst;
-  trimmed.erase(0, trimmed.find_first_not_of(" \t"));
+  MachineOperand operand;
+  operand.text = text;
+  if (text.empty())
+  {
+    return operand;
+  }
 
-  if (trimmed.find("addq $0,") == 0 || trimmed.find("subq $0,") == 0 ||
-      trimmed.find("addl $0,") == 0 || trimmed.find("subl $0,") == 0)
+  if (text[0] == '$')
+  {
+    try
+    {
+      operand.imm = std::stoll(text.substr(1));
+      operand.kind = MachineOperand::Kind::IMMEDIATE;
+    }
+    catch (...)
+    {
+      // Symbolic immediate ($label): leave as OTHER
+    }
+    return operand;
+  }
+  if (text[0] == '%')
   {
-    return true;
+    operand.kind = MachineOperand::Kind::REGISTER;
+    operand.reg = text;
+    return operand;
   }
-  return false;
+  size_t open = text.find('(');
+  size_t close = text.rfind(')');
+  if (open != std::string::npos && close != std::string::npos && close > open &&
+      open + 1 < close && text[open + 1] == '%')
+  {
+    std::string inner = text.substr(open + 1, close - open - 1);
+    if (inner.find(',') == std::string::npos)
+    { // No index/scale forms here
+      operand.kind = MachineOperand::Kind::MEMORY;
+      operand.base = inner;
+      try
+      {
+        operand.disp = (open == 0) ? 0 : std::stoll(text.substr(0, open));
+      }
+      catch (...)
+      {
+        operand.kind = MachineOperand::Kind::OTHER;
+      }
+      return operand;
+    }
+  }
+  return operand; // Label or unrecognized: OTHER
 }
 
-bool PeepholeOptimizer::isMultiplyByPowerOfTwo(const std::string &inst,
-                                               int &shiftAmount) const
+MachineInstr PeepholeOptimizer::parseLine(const std::string &line)
 {
-  // Pattern: imulq $N, %reg where N is a power of 2
-  std::string trimmed = inst;
-  trimmed.erase(0, trimmed.find_first_not_of(" \t"));
+  MachineInstr instr;
+  instr.raw = line;
 
-  if (trimmed.find("imulq $") != 0 && trimmed.find("imull $") != 0)
+  size_t begin = line.find_first_not_of(" \t");
+  size_t finish = line.find_last_not_of(" \t\n\r");
+  if (begin == std::string::npos)
   {
-    return false;
+    instr.kind = MachineInstr::Kind::BLANK;
+    return instr;
   }
+  std::string body = line.substr(begin, finish - begin + 1);
 
-  // Extract the constant
-  size_t dollarPos = trimmed.find('$');
-  size_t commaPos = trimmed.find(',');
-  if (dollarPos == std::string::npos || commaPos == std::string::npos)
+  if (body[0] == '#')
   {
-    return false;
+    instr.kind = MachineInstr::Kind::COMMENT;
+    return instr;
+  }
+  if (body[0] == '.')
+  {
+    instr.kind = MachineInstr::Kind::DIRECTIVE;
+    return instr;
+  }
+  if (body.back() == ':')
+  {
+    instr.kind = MachineInstr::Kind::LABEL_DEF;
+    return instr;
   }
 
-  std::string constStr =
-      trimmed.substr(dollarPos + 1, commaPos - dollarPos - 1);
-  try
+  instr.kind = MachineInstr::Kind::INSTRUCTION;
+  size_t space = body.find(' ');
+  if (space == std::string::npos)
   {
-    int value = std::stoi(constStr);
+    instr.opcode = body; // e.g. "ret", "cqto"
+    return instr;
+  }
+  instr.opcode = body.substr(0, space);
 
-    // Check if power of 2 (only one bit set)
-    if (value > 0 && (value & (value - 1)) == 0)
+  // Split operands on commas outside parentheses
+  std::string rest = body.substr(space + 1);
+  int depth = 0;
+  size_t tokenStart = 0;
+  auto pushToken = [&](size_t tokenEnd) {
+    std::string token = rest.substr(tokenStart, tokenEnd - tokenStart);
+    size_t ts = token.find_first_not_of(" \t");
+    size_t te = token.find_last_not_of(" \t");
+    if (ts != std::string::npos)
     {
-      // Calculate shift amount
-      shiftAmount = 0;
-      while ((1 << shiftAmount) != value)
-      {
-        shiftAmount++;
-      }
-      return true;
+      instr.operands.push_back(parseOperand(token.substr(ts, te - ts + 1)));
+    }
+  };
+  for (size_t i = 0; i < rest.size(); ++i)
+  {
+    if (rest[i] == '(')
+      depth++;
+    else if (rest[i] == ')')
+      depth--;
+    else if (rest[i] == ',' && depth == 0)
+    {
+      pushToken(i);
+      tokenStart = i + 1;
     }
   }
-  catch (...)
-  {
-    return false;
-  }
-
-  return false;
+  pushToken(rest.size());
+  return instr;
 }
 
-bool PeepholeOptimizer::isPushPopPair(size_t index) const
+void PeepholeOptimizer::addInstruction(const std::string &inst)
 {
-  // Pattern: pushq %rax followed by popq %rax
-  if (index + 1 >= instructions.size())
-    return false;
-
-  std::string inst1 = instructions[index];
-  std::string inst2 = instructions[index + 1];
-
-  // Trim leading whitespace
-  inst1.erase(0, inst1.find_first_not_of(" \t"));
-  inst2.erase(0, inst2.find_first_not_of(" \t"));
+  instructions.push_back(parseLine(inst));
+}
 
-  if (inst1.find("pushq ") != 0 || inst2.find("popq ") != 0)
+size_t PeepholeOptimizer::nextInstruction(size_t index) const
+{
+  // Window patterns must never pair instructions across a label (or a
+  // directive): code entering at the label sees different register
+  // contents, so only comments, blanks and dead entries are transparent.
+  while (index < instructions.size() && !instructions[index].isInstruction())
   {
-    return false;
+    MachineInstr::Kind kind = instructions[index].kind;
+    if (kind == MachineInstr::Kind::LABEL_DEF ||
+        kind == MachineInstr::Kind::DIRECTIVE)
+    {
+      return instructions.size(); // Window ends at the block boundary
+    }
+    ++index;
   }
-
-  // Extract register from both
-  std::string reg1 = inst1.substr(6); // Skip "pushq "
-  std::string reg2 = inst2.substr(5); // Skip "popq "
-
-  // Trim whitespace
-  reg1.erase(0, reg1.find_first_not_of(" \t"));
-  reg1.erase(reg1.find_last_not_of(" \t\n\r") + 1);
-  reg2.erase(0, reg2.find_first_not_of(" \t"));
-  reg2.erase(reg2.find_last_not_of(" \t\n\r") + 1);
-
-  return reg1 == reg2;
+  return index;
 }
 
-bool PeepholeOptimizer::isRedundantComparison(size_t index) const
+namespace
 {
-  // Pattern: cmpq followed immediately by another cmpq (second one overwrites
-  // flags)
-  if (index + 1 >= instructions.size())
-    return false;
-
-  std::string inst1 = instructions[index];
-  std::string inst2 = instructions[index + 1];
-
-  // Trim leading whitespace
-  inst1.erase(0, inst1.find_first_not_of(" \t"));
-  inst2.erase(0, inst2.find_first_not_of(" \t"));
-
-  // Both must be compare instructions
-  if ((inst1.find("cmpq ") != 0 && inst1.find("cmpl ") != 0) ||
-      (inst2.find("cmpq ") != 0 && inst2.find("cmpl ") != 0))
+  // Opcode predicates over the parsed form
+  inline bool isMovOpcode(const std::string &opcode)
   {
-    return false;
+    return opcode == "movq" || opcode == "movl" || opcode == "movw" ||
+           opcode == "movb";
+  }
+  inline bool isJccOrSetcc(const std::string &opcode)
+  {
+    return (opcode.size() > 1 && opcode[0] == 'j' && opcode != "jmp") ||
+           opcode.rfind("set", 0) == 0;
   }
-
-  // Check if there's no conditional jump or setcc between them
-  // If the next instruction is also a cmp, the first is redundant
-  return true;
 }
 
-std::string PeepholeOptimizer::optimizeMultiplyToShift(const std::string &inst,
-                                                       int shiftAmount) const
+// Pattern: mov %reg, %reg (same register)
+int PeepholeOptimizer::removeRedundantMoves()
 {
-  // Convert: imulq $8, %rax -> shlq $3, %rax
-  // Preserve leading whitespace
-  size_t firstNonSpace = inst.find_first_not_of(" \t");
-  std::string leadingSpace = inst.substr(0, firstNonSpace);
-
-  std::string trimmed = inst.substr(firstNonSpace);
-  size_t commaPos = trimmed.find(',');
-  std::string destReg = trimmed.substr(commaPos); // Includes ", %reg"
-
-  std::string prefix = (trimmed.find("imulq") == 0) ? "shlq" : "shll";
-  return leadingSpace + prefix + " $" + std::to_string(shiftAmount) + destReg;
+  int changes = 0;
+  for (size_t i = 0; i < instructions.size();)
+  {
+    const MachineInstr &instr = instructions[i];
+    if (instr.isInstruction() && isMovOpcode(instr.opcode) &&
+        instr.operands.size() == 2 &&
+        instr.operands[0].kind == MachineOperand::Kind::REGISTER &&
+        instr.operands[1].kind == MachineOperand::Kind::REGISTER &&
+        instr.operands[0].reg == instr.operands[1].reg)
+    {
+      instructions[i].dead = true;
+      changes++;
+    }
+    ++i;
+  }
+  return changes;
 }
 
-void PeepholeOptimizer::removeInstruction(size_t index)
+// Pattern: add/sub $0, <anything>
+int PeepholeOptimizer::removeArithmeticWithZero()
 {
-  if (index < instructions.size())
+  int changes = 0;
+  for (size_t i = 0; i < instructions.size();)
   {
-    instructions.erase(instructions.begin() + index);
+    const MachineInstr &instr = instructions[i];
+    bool isAddSub = instr.isInstruction() &&
+                    (instr.opcode == "addq" || instr.opcode == "subq" ||
+                     instr.opcode == "addl" || instr.opcode == "subl");
+    if (isAddSub && instr.operands.size() == 2 &&
+        instr.operands[0].kind == MachineOperand::Kind::IMMEDIATE &&
+        instr.operands[0].imm == 0)
+    {
+      instructions[i].dead = true;
+      changes++;
+    }
+    ++i;
   }
+  return changes;
 }
 
-void PeepholeOptimizer::replaceInstruction(size_t index,
-                                           const std::string &newInst)
+// Pattern: imul $2^k, %reg  ->  shl $k, %reg
+int PeepholeOptimizer::strengthReduceMultiplies()
 {
-  if (index < instructions.size())
+  int changes = 0;
+  for (auto &instr : instructions)
   {
-    instructions[index] = newInst;
+    if (!instr.isInstruction() ||
+        (instr.opcode != "imulq" && instr.opcode != "imull") ||
+        instr.operands.size() != 2 ||
+        instr.operands[0].kind != MachineOperand::Kind::IMMEDIATE)
+    {
+      continue;
+    }
+    long long value = instr.operands[0].imm;
+    if (value <= 0 || (value & (value - 1)) != 0)
+    {
+      continue;
+    }
+    int shift = 0;
+    while ((1LL << shift) != value)
+    {
+      shift++;
+    }
+    instr.opcode = (instr.opcode == "imulq") ? "shlq" : "shll";
+    instr.operands[0].imm = shift;
+    instr.operands[0].text = "$" + std::to_string(shift);
+    instr.modified = true;
+    changes++;
   }
+  return changes;
 }
 
-void PeepholeOptimizer::optimize()
+// Pattern: pushq %reg immediately followed by popq %reg
+int PeepholeOptimizer::removePushPopPairs()
 {
-  if (!optimizationEnabled)
-    return;
-
-  bool changed = true;
-  int passes = 0;
-  const int MAX_PASSES = 5; // Prevent infinite loops
-
-  while (changed && passes < MAX_PASSES)
+  int changes = 0;
+  for (size_t i = 0; i < instructions.size();)
   {
-    changed = false;
-    passes++;
-
-    // Pass 1: Remove redundant moves
-    for (size_t i = 0; i < instructions.size();)
+    const MachineInstr &first = instructions[i];
+    size_t j = (first.isInstruction() && first.opcode == "pushq")
+                   ? nextInstruction(i + 1)
+                   : instructions.size();
+    if (j < instructions.size())
     {
-      if (isRedundantMove(instructions[i]))
+      const MachineInstr &second = instructions[j];
+      if (second.opcode == "popq" && first.operands.size() == 1 &&
+          second.operands.size() == 1 &&
+          first.operands[0].kind == MachineOperand::Kind::REGISTER &&
+          first.operands[0].reg == second.operands[0].reg)
       {
-        removeInstruction(i);
-        changed = true;
-        // Don't increment i, check the same position again
-      }
-      else
-      {
-        i++;
+        instructions[j].dead = true;
+        instructions[i].dead = true;
+        changes++;
+        continue;
       }
     }
+    ++i;
+  }
+  return changes;
+}
 
-    // Pass 2: Remove arithmetic with zero
-    for (size_t i = 0; i < instructions.size();)
+// Pattern: cmp whose flags are overwritten by the next real instruction
+// being another cmp (nothing read them in between)
+int PeepholeOptimizer::removeOverwrittenComparisons()
+{
+  int changes = 0;
+  for (size_t i = 0; i < instructions.size();)
+  {
+    const MachineInstr &first = instructions[i];
+    bool isCmp = first.isInstruction() &&
+                 (first.opcode == "cmpq" || first.opcode == "cmpl");
+    if (isCmp)
     {
-      if (isArithmeticWithZero(instructions[i]))
-      {
-        removeInstruction(i);
-        changed = true;
-      }
-      else
+      size_t j = nextInstruction(i + 1);
+      if (j < instructions.size() &&
+          (instructions[j].opcode == "cmpq" ||
+           instructions[j].opcode == "cmpl"))
       {
-        i++;
+        instructions[i].dead = true;
+        changes++;
+        continue;
       }
     }
+    ++i;
+  }
+  return changes;
+}
 
-    // Pass 3: Convert multiply by power of 2 to shift
-    for (size_t i = 0; i < instructions.size(); i++)
+// Pattern: movq %reg, D(%rbp) directly followed by movq D(%rbp), %reg2.
+// The value is still in %reg: drop the reload (same register) or turn it
+// into a register move (different register). The store stays - the slot
+// may be read again later.
+int PeepholeOptimizer::removeSpillReloads()
+{
+  int changes = 0;
+  for (size_t i = 0; i < instructions.size(); ++i)
+  {
+    const MachineInstr &store = instructions[i];
+    if (!store.isInstruction() || store.opcode != "movq" ||
+        store.operands.size() != 2 ||
+        store.operands[0].kind != MachineOperand::Kind::REGISTER ||
+        store.operands[1].kind != MachineOperand::Kind::MEMORY ||
+        store.operands[1].base != "%rbp")
     {
-      int shiftAmount;
-      if (isMultiplyByPowerOfTwo(instructions[i], shiftAmount))
-      {
-        std::string newInst =
-            optimizeMultiplyToShift(instructions[i], shiftAmount);
-        replaceInstruction(i, newInst);
-        changed = true;
-      }
+      continue;
+    }
+    size_t j = nextInstruction(i + 1);
+    if (j >= instructions.size())
+    {
+      continue;
+    }
+    MachineInstr &reload = instructions[j];
+    if (reload.opcode != "movq" || reload.operands.size() != 2 ||
+        reload.operands[0].kind != MachineOperand::Kind::MEMORY ||
+        reload.operands[0].base != "%rbp" ||
+        reload.operands[0].disp != store.operands[1].disp ||
+        reload.operands[1].kind != MachineOperand::Kind::REGISTER)
+    {
+      continue;
+    }
+    if (reload.operands[1].reg == store.operands[0].reg)
+    {
+      instructions[j].dead = true; // Value already there
+    }
+    else
+    {
+      reload.operands[0] = store.operands[0]; // Reg-to-reg move instead
+      reload.modified = true;
+    }
+    changes++;
+  }
+  return changes;
+}
+
+// Pattern: cmpq $0, %reg  ->  testq %reg, %reg (shorter encoding; ZF/SF
+// identical and OF/CF are zero either way, so every jcc behaves the same)
+int PeepholeOptimizer::rewriteCompareZeroAsTest()
+{
+  int changes = 0;
+  for (auto &instr : instructions)
+  {
+    if (!instr.isInstruction() || instr.opcode != "cmpq" ||
+        instr.operands.size() != 2 ||
+        instr.operands[0].kind != MachineOperand::Kind::IMMEDIATE ||
+        instr.operands[0].imm != 0 ||
+        instr.operands[1].kind != MachineOperand::Kind::REGISTER)
+    {
+      continue;
     }
+    instr.opcode = "testq";
+    instr.operands[0] = instr.operands[1];
+    instr.modified = true;
+    changes++;
+  }
+  return changes;
+}
 
-    // Pass 4: Remove push/pop pairs
-    for (size_t i = 0; i < instructions.size();)
+// Pattern: movq %rA, %rB followed by addq $imm, %rB  ->  leaq imm(%rA), %rB.
+// Skipped when the instruction after the pair reads flags (lea does not
+// set them, add does).
+int PeepholeOptimizer::fuseLea()
+{
+  int changes = 0;
+  for (size_t i = 0; i < instructions.size(); ++i)
+  {
+    const MachineInstr &move = instructions[i];
+    if (!move.isInstruction() || move.opcode != "movq" ||
+        move.operands.size() != 2 ||
+        move.operands[0].kind != MachineOperand::Kind::REGISTER ||
+        move.operands[1].kind != MachineOperand::Kind::REGISTER)
+    {
+      continue;
+    }
+    size_t j = nextInstruction(i + 1);
+    if (j >= instructions.size())
     {
-      if (isPushPopPair(i))
+      continue;
+    }
+    MachineInstr &add = instructions[j];
+    if (add.opcode != "addq" || add.operands.size() != 2 ||
+        add.operands[0].kind != MachineOperand::Kind::IMMEDIATE ||
+        add.operands[1].kind != MachineOperand::Kind::REGISTER ||
+        add.operands[1].reg != move.operands[1].reg)
+    {
+      continue;
+    }
+    // Conservative flag check: lea does not set flags where add does. A
+    // following jcc/setcc blocks the fusion, and so does a label — code
+    // after it may be reached with the add's flags live on fallthrough,
+    // and we cannot see past the boundary.
+    bool flagsMayBeRead = false;
+    for (size_t k = j + 1; k < instructions.size(); ++k)
+    {
+      const MachineInstr &following = instructions[k];
+      if (following.kind == MachineInstr::Kind::COMMENT ||
+          following.kind == MachineInstr::Kind::BLANK || following.dead)
+      {
+        continue;
+      }
+      if (following.isInstruction())
       {
-        removeInstruction(i); // Remove push
-        removeInstruction(i); // Remove pop (now at same index)
-        changed = true;
+        flagsMayBeRead = isJccOrSetcc(following.opcode);
       }
       else
       {
-        i++;
+        flagsMayBeRead = true; // Label/directive: unknown successors
       }
+      break;
+    }
+    if (flagsMayBeRead)
+    {
+      continue; // Something may read the add's flags
     }
 
-    // Pass 5: Remove redundant comparisons
-    for (size_t i = 0; i + 1 < instructions.size();)
+    add.opcode = "leaq";
+    MachineOperand memOperand;
+    memOperand.kind = MachineOperand::Kind::MEMORY;
+    memOperand.base = move.operands[0].reg;
+    memOperand.disp = add.operands[0].imm;
+    memOperand.text =
+        std::to_string(add.operands[0].imm) + "(" + move.operands[0].reg + ")";
+    add.operands[0] = memOperand;
+    add.modified = true;
+    instructions[i].dead = true;
+    changes++;
+  }
+  return changes;
+}
+
+// Single O(n) sweep removing everything the pattern passes marked dead
+void PeepholeOptimizer::compact()
+{
+  size_t write = 0;
+  for (size_t read = 0; read < instructions.size(); ++read)
+  {
+    if (!instructions[read].dead)
     {
-      if (isRedundantComparison(i))
-      {
-        removeInstruction(i); // Keep the second comparison
-        changed = true;
-      }
-      else
+      if (write != read)
       {
-        i++;
+        instructions[write] = std::move(instructions[read]);
       }
+      ++write;
     }
   }
+  instructions.resize(write);
+}
+
+void PeepholeOptimizer::optimize()
+{
+  if (!optimizationEnabled)
+    return;
+
+  bool changed = true;
+  int passes = 0;
+  const int MAX_PASSES = 5; // Prevent infinite loops
+
+  while (changed && passes < MAX_PASSES)
+  {
+    changed = false;
+    passes++;
+
+    changed |= removeRedundantMoves() > 0;
+    changed |= removeArithmeticWithZero() > 0;
+    changed |= strengthReduceMultiplies() > 0;
+    changed |= removePushPopPairs() > 0;
+    changed |= removeOverwrittenComparisons() > 0;
+    changed |= removeSpillReloads() > 0;
+    changed |= rewriteCompareZeroAsTest() > 0;
+    changed |= fuseLea() > 0;
+
+    // One compaction per iteration instead of a vector::erase per match
+    compact();
+  }
 }
 
 std::string PeepholeOptimizer::getOptimizedCode() const
@@ -635,9 +1198,9 @@ std::string PeepholeOptimizer::getOptimizedCode() const
   std::ostringstream result;
   for (const auto &inst : instructions)
   {
-    result << inst;
-    // Instructions should already have newlines
-    if (!inst.empty() && inst.back() != '\n')
+    std::string text = inst.render();
+    result << text;
+    if (!text.empty() && text.back() != '\n')
     {
       result << "\n";
     }
@@ -1222,13 +1785,16 @@ void CodeGenerator::emitDivisionInst(const IRInstruction *inst)
   bool src1IsRax = (src1 == "%rax");
   bool src1IsRdx = (src1 == "%rdx");
 
-  // Save RAX to R10 if we need it later and it's not the destination
-  if (!destIsRax && !src1IsRax)
+  // Save RAX and RDX unconditionally (unless the destination overwrites
+  // them anyway): the emitter cannot see liveness, and either register
+  // may hold a value that is read again after the division — including
+  // the dividend or divisor themselves, which the dividend load and cqto
+  // destroy below.
+  if (!destIsRax)
   {
     emit("movq %rax, %r10");
   }
-  // Save RDX to R11 if we need it later and it's not the destination
-  if (!destIsRdx && !src1IsRdx)
+  if (!destIsRdx)
   {
     emit("movq %rdx, %r11");
   }
@@ -1261,6 +1827,16 @@ void CodeGenerator::emitDivisionInst(const IRInstruction *inst)
       divisor = "(%rsp)";
     }
   }
+  // The dividend setup destroyed %rax (dividend load) and %rdx (cqto);
+  // a divisor that lived in either must come from its saved copy.
+  if (divisor == "%rax")
+  {
+    divisor = "%r10";
+  }
+  else if (divisor == "%rdx")
+  {
+    divisor = "%r11";
+  }
   emit("idivq " + divisor);
 
   // Clean up if we pushed the divisor
@@ -1287,12 +1863,13 @@ void CodeGenerator::emitDivisionInst(const IRInstruction *inst)
     }
   }
 
-  // Step 6: Restore RAX and RDX from scratch registers if we saved them
-  if (!destIsRax && !src1IsRax)
+  // Step 6: Restore RAX and RDX from the scratch copies (the destination
+  // register keeps the result instead)
+  if (!destIsRax)
   {
     emit("movq %r10, %rax");
   }
-  if (!destIsRdx && !src1IsRdx)
+  if (!destIsRdx)
   {
     emit("movq %r11, %rdx");
   }
@@ -1351,6 +1928,16 @@ void CodeGenerator::emitComparisonInst(const IRInstruction *inst)
   emitComment(result->getSSAName() + " = " + operands[0].toString() + " cmp " +
               operands[1].toString());
 
+  // x86 has no memory/memory compare: when the spill choices leave both
+  // operands in stack slots, stage the left side through %r11 (the
+  // reserved spill scratch, never holding a live value) first.
+  if (src1.find("(%rbp)") != std::string::npos &&
+      src2.find("(%rbp)") != std::string::npos)
+  {
+    emit("movq " + src1 + ", %r11");
+    src1 = "%r11";
+  }
+
   // Compare instruction: AT&T syntax is "cmp src, dst" but semantics are dst -
   // src So cmpq $5, %rax compares rax with 5 (rax - 5)
   emit("cmpq " + src2 + ", " + src1);
@@ -1842,18 +2429,16 @@ void CodeGenerator::emitParamInst(const IRInstruction *inst)
 {
   // PARAM instructions are typically handled during function prologue
   // They map parameters from calling convention registers to local variables
-  const auto &operands = inst->getOperands();
-  if (operands.empty())
-    return;
-
   SSAValue *result = inst->getResult();
   if (!result)
     return;
 
   emitComment("Parameter: " + result->getSSAName());
 
-  // Get parameter index (from operand)
-  int paramIndex = std::stoi(operands[0].getConstant());
+  // ParamInst carries its index as a field (it has no operands); reading
+  // it from operands[0] used to bail out above and silently skip the
+  // ABI-register-to-local move for every parameter.
+  int paramIndex = static_cast<const ParamInst *>(inst)->getParamIndex();
 
   std::vector<std::string> paramRegs = {"%rdi", "%rsi", "%rdx",
                                         "%rcx", "%r8", "%r9"};
@@ -1923,8 +2508,15 @@ std::string CodeGenerator::generateFunction(IRFunction *function)
   // Emit instructions for each basic block
   for (const auto &block : function->getBasicBlocks())
   {
-    // Emit block label (if not entry)
-    if (block->getLabel() != "entry")
+    // Emit block label (if not entry). Blocks created by the CFG split
+    // carry the same label as their leading LabelInst, which emits it
+    // anyway — skip the duplicate definition.
+    bool startsWithSameLabel =
+        !block->getInstructions().empty() &&
+        block->getInstructions().front()->getOpcode() == IROpcode::LABEL &&
+        static_cast<const LabelInst *>(block->getInstructions().front().get())
+                ->getLabelName() == block->getLabel();
+    if (block->getLabel() != "entry" && !startsWithSameLabel)
     {
       // Newline before block label must go through peephole buffer for correct ordering
       if (peepholeOptimizationEnabled)
@@ -2022,6 +2614,18 @@ std::string CodeGenerator::generateFunction(IRFunction *function)
 
 std::string CodeGenerator::generateProgram(
     const std::vector<std::unique_ptr<IRFunction>> &functions)
+{
+  std::vector<IRFunction *> borrowed;
+  borrowed.reserve(functions.size());
+  for (const auto &function : functions)
+  {
+    borrowed.push_back(function.get());
+  }
+  return generateProgram(borrowed);
+}
+
+std::string CodeGenerator::generateProgram(
+    const std::vector<IRFunction *> &functions)
 {
   reset();
 
@@ -2060,7 +2664,7 @@ std::string CodeGenerator::generateProgram(
   output.str("");
   output.clear();
 
-  for (const auto &function : functions)
+  for (IRFunction *function : functions)
   {
     if (function->getIsExtern())
     {
@@ -2068,7 +2672,7 @@ std::string CodeGenerator::generateProgram(
     }
     else
     {
-      generateFunction(function.get());
+      generateFunction(function);
     }
   }
 
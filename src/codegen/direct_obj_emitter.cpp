@@ -0,0 +1,483 @@
+#include "direct_obj_emitter.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+// ============================================================================
+// Register tables
+// ============================================================================
+// Encoding info for the registers the emitter touches. `low3` is the
+// 3-bit register number; `extended` marks r8-r15 (needs a REX extension
+// bit). The emitter's scheme: %rax/%rcx are instruction scratch, the six
+// System V argument registers are only ever written from slots/immediates.
+namespace {
+
+struct Reg
+{
+    uint8_t low3;
+    bool extended;
+};
+
+constexpr Reg RAX = {0, false};
+constexpr Reg RCX = {1, false};
+constexpr Reg RDX = {2, false};
+constexpr Reg RSI = {6, false};
+constexpr Reg RDI = {7, false};
+constexpr Reg R8 = {0, true};
+constexpr Reg R9 = {1, true};
+
+// System V AMD64 integer argument registers, in order
+constexpr Reg kArgRegs[6] = {RDI, RSI, RDX, RCX, R8, R9};
+
+} // namespace
+
+void DirectObjectEmitter::bytes(std::initializer_list<uint8_t> list)
+{
+    text_.insert(text_.end(), list.begin(), list.end());
+}
+
+void DirectObjectEmitter::imm32(int32_t value)
+{
+    uint32_t bits = static_cast<uint32_t>(value);
+    byte(static_cast<uint8_t>(bits));
+    byte(static_cast<uint8_t>(bits >> 8));
+    byte(static_cast<uint8_t>(bits >> 16));
+    byte(static_cast<uint8_t>(bits >> 24));
+}
+
+bool DirectObjectEmitter::fail(const std::string& reason)
+{
+    if (reason_.empty()) {
+        reason_ = reason;
+    }
+    return false;
+}
+
+// Allocate (or look up) the stack slot for an SSA value.
+int DirectObjectEmitter::slotFor(const SSAValue& value)
+{
+    auto it = slots_.find(value.getId());
+    if (it != slots_.end()) {
+        return it->second;
+    }
+    int slot = static_cast<int>(slots_.size());
+    slots_[value.getId()] = slot;
+    return slot;
+}
+
+// Parse an integer constant operand; rejects floats/strings and values
+// that do not fit in a sign-extended imm32.
+bool DirectObjectEmitter::constantValue(const IROperand& operand,
+                                        int64_t& value)
+{
+    const std::string& text = operand.getConstant();
+    if (text.empty()) {
+        return false;
+    }
+    char* end = nullptr;
+    value = std::strtoll(text.c_str(), &end, 0);
+    if (end == nullptr || *end != '\0') {
+        return false; // Not a plain integer (float literal, string, ...)
+    }
+    return value >= INT32_MIN && value <= INT32_MAX;
+}
+
+// mov <operand> -> reg. Immediates use REX.W C7 /0 imm32 (sign-extended);
+// slots use REX.W 8B /r with an rbp-relative disp32.
+bool DirectObjectEmitter::loadOperand(const IROperand& operand, int regIndex)
+{
+    // regIndex: 0=rax, 1=rcx, 2..7 = argument registers 0..5
+    Reg reg = (regIndex == 0) ? RAX : (regIndex == 1) ? RCX
+                                                      : kArgRegs[regIndex - 2];
+    if (operand.isConstant()) {
+        int64_t value = 0;
+        if (!constantValue(operand, value)) {
+            return fail("non-integer constant '" + operand.getConstant() + "'");
+        }
+        byte(reg.extended ? 0x49 : 0x48); // REX.W (+B for r8/r9)
+        byte(0xC7);
+        byte(0xC0 | reg.low3);
+        imm32(static_cast<int32_t>(value));
+        return true;
+    }
+    if (operand.isSSAValue()) {
+        const SSAValue& value = operand.getSSAValue();
+        const std::string& type = value.getType();
+        if (type.find('*') != std::string::npos || type == "float" ||
+            type == "double") {
+            return fail("unsupported operand type '" + type + "'");
+        }
+        byte(reg.extended ? 0x4C : 0x48); // REX.W (+R for r8/r9)
+        byte(0x8B);
+        byte(0x85 | (reg.low3 << 3)); // [rbp + disp32]
+        imm32(slotDisp(slotFor(value)));
+        return true;
+    }
+    return fail("label used as data operand");
+}
+
+// mov %rax -> result slot
+void DirectObjectEmitter::storeResultFromRax(const SSAValue* result)
+{
+    if (result == nullptr) {
+        return;
+    }
+    bytes({0x48, 0x89, 0x85}); // mov %rax, disp32(%rbp)
+    imm32(slotDisp(slotFor(*result)));
+}
+
+void DirectObjectEmitter::emitProloguePlaceholder(size_t& frameSizePos)
+{
+    byte(0x55);                // push %rbp
+    bytes({0x48, 0x89, 0xE5}); // mov %rsp, %rbp
+    bytes({0x48, 0x81, 0xEC}); // sub $frame, %rsp
+    frameSizePos = text_.size();
+    imm32(0); // Patched once the slot count is known
+}
+
+bool DirectObjectEmitter::encodeInstruction(const IRInstruction* inst)
+{
+    IROpcode opcode = inst->getOpcode();
+    const auto& operands = inst->getOperands();
+
+    switch (opcode) {
+    case IROpcode::ADD:
+    case IROpcode::SUB:
+    case IROpcode::MUL:
+    case IROpcode::DIV:
+    case IROpcode::MOD: {
+        if (operands.size() != 2) {
+            return fail("malformed arithmetic instruction");
+        }
+        if (!loadOperand(operands[0], 0) || !loadOperand(operands[1], 1)) {
+            return false;
+        }
+        switch (opcode) {
+        case IROpcode::ADD:
+            bytes({0x48, 0x01, 0xC8}); // add %rcx, %rax
+            break;
+        case IROpcode::SUB:
+            bytes({0x48, 0x29, 0xC8}); // sub %rcx, %rax
+            break;
+        case IROpcode::MUL:
+            bytes({0x48, 0x0F, 0xAF, 0xC1}); // imul %rcx, %rax
+            break;
+        case IROpcode::DIV:
+            bytes({0x48, 0x99});             // cqto
+            bytes({0x48, 0xF7, 0xF9});       // idiv %rcx
+            break;
+        case IROpcode::MOD:
+            bytes({0x48, 0x99});             // cqto
+            bytes({0x48, 0xF7, 0xF9});       // idiv %rcx
+            bytes({0x48, 0x89, 0xD0});       // mov %rdx, %rax (remainder)
+            break;
+        default:
+            break;
+        }
+        storeResultFromRax(inst->getResult());
+        return true;
+    }
+
+    case IROpcode::EQ:
+    case IROpcode::NE:
+    case IROpcode::LT:
+    case IROpcode::GT:
+    case IROpcode::LE:
+    case IROpcode::GE: {
+        if (operands.size() != 2) {
+            return fail("malformed comparison instruction");
+        }
+        if (!loadOperand(operands[0], 0) || !loadOperand(operands[1], 1)) {
+            return false;
+        }
+        bytes({0x48, 0x39, 0xC8}); // cmp %rcx, %rax
+        uint8_t setcc = 0x94;      // sete
+        switch (opcode) {
+        case IROpcode::NE: setcc = 0x95; break; // setne
+        case IROpcode::LT: setcc = 0x9C; break; // setl
+        case IROpcode::GT: setcc = 0x9F; break; // setg
+        case IROpcode::LE: setcc = 0x9E; break; // setle
+        case IROpcode::GE: setcc = 0x9D; break; // setge
+        default: break;
+        }
+        bytes({0x0F, setcc, 0xC0});       // setcc %al
+        bytes({0x48, 0x0F, 0xB6, 0xC0});  // movzbq %al, %rax
+        storeResultFromRax(inst->getResult());
+        return true;
+    }
+
+    case IROpcode::MOVE:
+        if (operands.size() != 1 || !loadOperand(operands[0], 0)) {
+            return operands.size() == 1 ? false
+                                        : fail("malformed move instruction");
+        }
+        storeResultFromRax(inst->getResult());
+        return true;
+
+    case IROpcode::LABEL:
+        labelOffsets_[static_cast<const LabelInst*>(inst)->getLabelName()] =
+            text_.size();
+        return true;
+
+    case IROpcode::JUMP:
+        byte(0xE9); // jmp rel32 (may relax to EB rel8)
+        fixups_.push_back({text_.size(),
+                           static_cast<const JumpInst*>(inst)->getTargetLabel(),
+                           false});
+        imm32(0);
+        return true;
+
+    case IROpcode::JUMP_IF_FALSE: {
+        const auto* jump = static_cast<const JumpIfFalseInst*>(inst);
+        if (!loadOperand(jump->getCondition(), 0)) {
+            return false;
+        }
+        bytes({0x48, 0x85, 0xC0}); // test %rax, %rax
+        bytes({0x0F, 0x84});       // je rel32 (may relax to 74 rel8)
+        fixups_.push_back({text_.size(), jump->getTargetLabel(), true});
+        imm32(0);
+        return true;
+    }
+
+    case IROpcode::CALL: {
+        const auto* call = static_cast<const CallInst*>(inst);
+        if (operands.size() > 6) {
+            return fail("call with more than 6 arguments");
+        }
+        for (size_t i = 0; i < operands.size(); ++i) {
+            if (!loadOperand(operands[i], static_cast<int>(i) + 2)) {
+                return false;
+            }
+        }
+        byte(0xE8); // call rel32, resolved by the linker
+        callSites_.push_back({text_.size(), call->getFunctionName()});
+        imm32(0);
+        storeResultFromRax(inst->getResult());
+        return true;
+    }
+
+    case IROpcode::RETURN:
+        if (inst->getOperands().size() == 1 &&
+            !loadOperand(inst->getOperands()[0], 0)) {
+            return false;
+        }
+        byte(0xC9); // leave
+        byte(0xC3); // ret
+        return true;
+
+    case IROpcode::PARAM: {
+        const auto* param = static_cast<const ParamInst*>(inst);
+        SSAValue* result = inst->getResult();
+        if (result == nullptr) {
+            return true;
+        }
+        int index = param->getParamIndex();
+        if (index < 6) {
+            Reg reg = kArgRegs[index];
+            byte(reg.extended ? 0x4C : 0x48); // mov %arg, disp32(%rbp)
+            byte(0x89);
+            byte(0x85 | (reg.low3 << 3));
+            imm32(slotDisp(slotFor(*result)));
+        } else {
+            // Stack parameter: above the saved %rbp and return address
+            bytes({0x48, 0x8B, 0x85}); // mov disp32(%rbp), %rax
+            imm32(16 + 8 * (index - 6));
+            storeResultFromRax(result);
+        }
+        return true;
+    }
+
+    case IROpcode::LOAD:
+    case IROpcode::STORE:
+        return fail("memory instruction (pointers/arrays)");
+    case IROpcode::PHI:
+        return fail("phi instruction");
+    default:
+        return fail("unhandled opcode");
+    }
+}
+
+bool DirectObjectEmitter::emitFunction(IRFunction* function)
+{
+    // Align function starts for the ELF section's 16-byte alignment
+    while (text_.size() % 16 != 0) {
+        byte(0x90); // nop
+    }
+    uint64_t start = text_.size();
+
+    slots_.clear();
+    labelOffsets_.clear();
+    fixups_.clear();
+    callSites_.clear();
+
+    size_t frameSizePos = 0;
+    emitProloguePlaceholder(frameSizePos);
+
+    for (const auto& block : function->getBasicBlocks()) {
+        for (const auto& inst : block->getInstructions()) {
+            if (!encodeInstruction(inst.get())) {
+                return false;
+            }
+        }
+    }
+
+    // Fallthrough off the end (e.g. a void function without return)
+    byte(0xC9); // leave
+    byte(0xC3); // ret
+
+    // Patch the frame size: one 8-byte slot per value, kept 16-aligned so
+    // rsp stays 16-byte aligned at every call site.
+    int64_t frameSize = static_cast<int64_t>(slots_.size()) * 8;
+    frameSize = (frameSize + 15) & ~int64_t(15);
+    uint32_t frameBits = static_cast<uint32_t>(frameSize);
+    for (int i = 0; i < 4; ++i) {
+        text_[frameSizePos + i] = static_cast<uint8_t>(frameBits >> (i * 8));
+    }
+
+    // Resolve branches in one fixup pass, relaxing to short forms
+    if (!resolveBranches(start)) {
+        return false;
+    }
+
+    writer_.addFunction(function->getName(), start, text_.size() - start);
+    return true;
+}
+
+// Resolve all of the function's branches against the label table built
+// during the single encoding pass, picking the 2-byte rel8 forms (EB for
+// jmp, 74 for je) whenever the displacement fits. Shrinking moves later
+// code, so fit decisions iterate to a fixpoint (shrinking only ever
+// shortens distances) before the function's bytes are rebuilt once and
+// call-site relocations are registered at their final offsets.
+bool DirectObjectEmitter::resolveBranches(uint64_t functionStart)
+{
+    const int kLongSize[2] = {5, 6};  // E9 rel32 / 0F 84 rel32
+    const int kShortSize = 2;         // EB rel8  / 74 rel8
+
+    struct Branch
+    {
+        uint64_t opcodePos; // First byte of the long form
+        uint64_t fixupPos;  // rel32 position
+        uint64_t target;    // Unadjusted label offset
+        bool conditional;
+        bool shrunk = false;
+    };
+    std::vector<Branch> branches;
+    branches.reserve(fixups_.size());
+    for (const Fixup& fixup : fixups_) {
+        auto it = labelOffsets_.find(fixup.label);
+        if (it == labelOffsets_.end()) {
+            return fail("jump to unknown label '" + fixup.label + "'");
+        }
+        branches.push_back({fixup.pos - (fixup.conditional ? 2 : 1), fixup.pos,
+                            it->second, fixup.conditional, false});
+    }
+
+    // Bytes saved by every shrunk branch that starts before `pos`
+    auto savingsBefore = [&](uint64_t pos) {
+        int64_t saved = 0;
+        for (const Branch& branch : branches) {
+            if (branch.shrunk && branch.opcodePos < pos) {
+                saved += kLongSize[branch.conditional ? 1 : 0] - kShortSize;
+            }
+        }
+        return saved;
+    };
+
+    // Fixpoint: try to shrink every branch under current adjusted offsets
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (Branch& branch : branches) {
+            if (branch.shrunk) {
+                continue;
+            }
+            int64_t adjEnd = static_cast<int64_t>(branch.opcodePos) -
+                             savingsBefore(branch.opcodePos) + kShortSize;
+            int64_t adjTarget = static_cast<int64_t>(branch.target) -
+                                savingsBefore(branch.target);
+            int64_t rel = adjTarget - adjEnd;
+            if (rel >= -128 && rel <= 127) {
+                branch.shrunk = true;
+                changed = true;
+            }
+        }
+    }
+
+    // Rebuild the function's bytes with final forms and displacements
+    std::vector<uint8_t> rebuilt;
+    rebuilt.reserve(text_.size() - functionStart);
+    uint64_t cursor = functionStart;
+    std::vector<Branch*> ordered;
+    for (Branch& branch : branches) {
+        ordered.push_back(&branch);
+    }
+    std::sort(ordered.begin(), ordered.end(),
+              [](const Branch* a, const Branch* b) {
+                  return a->opcodePos < b->opcodePos;
+              });
+
+    auto adjOffset = [&](uint64_t pos) {
+        return static_cast<int64_t>(pos) - savingsBefore(pos);
+    };
+
+    for (Branch* branch : ordered) {
+        rebuilt.insert(rebuilt.end(), text_.begin() + cursor,
+                       text_.begin() + branch->opcodePos);
+        int64_t adjTarget = adjOffset(branch->target);
+        if (branch->shrunk) {
+            int64_t adjEnd = adjOffset(branch->opcodePos) + kShortSize;
+            rebuilt.push_back(branch->conditional ? 0x74 : 0xEB);
+            rebuilt.push_back(static_cast<uint8_t>(
+                static_cast<int8_t>(adjTarget - adjEnd)));
+        } else {
+            int size = kLongSize[branch->conditional ? 1 : 0];
+            int64_t adjEnd = adjOffset(branch->opcodePos) + size;
+            if (branch->conditional) {
+                rebuilt.push_back(0x0F);
+                rebuilt.push_back(0x84);
+            } else {
+                rebuilt.push_back(0xE9);
+            }
+            uint32_t bits =
+                static_cast<uint32_t>(static_cast<int32_t>(adjTarget - adjEnd));
+            for (int i = 0; i < 4; ++i) {
+                rebuilt.push_back(static_cast<uint8_t>(bits >> (i * 8)));
+            }
+        }
+        cursor = branch->opcodePos + kLongSize[branch->conditional ? 1 : 0];
+    }
+    rebuilt.insert(rebuilt.end(), text_.begin() + cursor, text_.end());
+
+    // Register call relocations at their final (shifted) offsets
+    for (const auto& site : callSites_) {
+        writer_.addCallRelocation(
+            static_cast<uint64_t>(adjOffset(site.first)), site.second);
+    }
+
+    text_.resize(functionStart);
+    text_.insert(text_.end(), rebuilt.begin(), rebuilt.end());
+    return true;
+}
+
+bool DirectObjectEmitter::emit(const std::vector<IRFunction*>& functions,
+                               const std::string& objPath)
+{
+    text_.clear();
+    reason_.clear();
+
+    for (IRFunction* function : functions) {
+        if (function->getIsExtern()) {
+            continue; // Calls get relocations; nothing to define
+        }
+        if (!emitFunction(function)) {
+            return false; // reason_ set; caller falls back to text path
+        }
+    }
+
+    writer_.setText(std::move(text_));
+    if (!writer_.write(objPath)) {
+        return fail("cannot write object file " + objPath);
+    }
+    return true;
+}
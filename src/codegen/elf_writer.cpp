@@ -0,0 +1,303 @@
+#include "elf_writer.h"
+
+#include <cstring>
+#include <fstream>
+#include <map>
+
+// ============================================================================
+// Minimal ELF64 structure definitions
+// ============================================================================
+// Spelled out locally instead of relying on <elf.h> so the writer also
+// builds on non-ELF hosts (the constants are fixed by the ABI anyway).
+namespace {
+
+struct Elf64_Ehdr
+{
+    uint8_t e_ident[16];
+    uint16_t e_type;
+    uint16_t e_machine;
+    uint32_t e_version;
+    uint64_t e_entry;
+    uint64_t e_phoff;
+    uint64_t e_shoff;
+    uint32_t e_flags;
+    uint16_t e_ehsize;
+    uint16_t e_phentsize;
+    uint16_t e_phnum;
+    uint16_t e_shentsize;
+    uint16_t e_shnum;
+    uint16_t e_shstrndx;
+};
+
+struct Elf64_Shdr
+{
+    uint32_t sh_name;
+    uint32_t sh_type;
+    uint64_t sh_flags;
+    uint64_t sh_addr;
+    uint64_t sh_offset;
+    uint64_t sh_size;
+    uint32_t sh_link;
+    uint32_t sh_info;
+    uint64_t sh_addralign;
+    uint64_t sh_entsize;
+};
+
+struct Elf64_Sym
+{
+    uint32_t st_name;
+    uint8_t st_info;
+    uint8_t st_other;
+    uint16_t st_shndx;
+    uint64_t st_value;
+    uint64_t st_size;
+};
+
+struct Elf64_Rela
+{
+    uint64_t r_offset;
+    uint64_t r_info;
+    int64_t r_addend;
+};
+
+constexpr uint16_t ET_REL = 1;
+constexpr uint16_t EM_X86_64 = 62;
+constexpr uint32_t SHT_PROGBITS = 1;
+constexpr uint32_t SHT_SYMTAB = 2;
+constexpr uint32_t SHT_STRTAB = 3;
+constexpr uint32_t SHT_RELA = 4;
+constexpr uint64_t SHF_ALLOC = 0x2;
+constexpr uint64_t SHF_EXECINSTR = 0x4;
+constexpr uint64_t SHF_INFO_LINK = 0x40;
+constexpr uint8_t STB_LOCAL = 0;
+constexpr uint8_t STB_GLOBAL = 1;
+constexpr uint8_t STT_SECTION = 3;
+constexpr uint8_t STT_FUNC = 2;
+constexpr uint8_t STT_NOTYPE = 0;
+constexpr uint32_t R_X86_64_PLT32 = 4;
+
+inline uint8_t symInfo(uint8_t bind, uint8_t type)
+{
+    return static_cast<uint8_t>((bind << 4) | (type & 0xF));
+}
+
+// Simple string table builder: offset 0 is the empty string.
+class StringTable
+{
+public:
+    StringTable() : data_(1, '\0') {}
+
+    uint32_t add(const std::string& text)
+    {
+        uint32_t offset = static_cast<uint32_t>(data_.size());
+        data_.insert(data_.end(), text.begin(), text.end());
+        data_.push_back('\0');
+        return offset;
+    }
+
+    const std::vector<char>& data() const { return data_; }
+
+private:
+    std::vector<char> data_;
+};
+
+} // namespace
+
+void ElfObjectWriter::addFunction(const std::string& name, uint64_t offset,
+                                  uint64_t size)
+{
+    functions_.push_back({name, offset, size});
+}
+
+void ElfObjectWriter::addCallRelocation(uint64_t offset,
+                                        const std::string& symbol)
+{
+    relocations_.push_back({offset, symbol});
+}
+
+bool ElfObjectWriter::write(const std::string& path) const
+{
+    // Section indices (fixed layout):
+    // 0 null, 1 .text, 2 .rela.text, 3 .symtab, 4 .strtab, 5 .shstrtab
+    constexpr uint16_t kTextIndex = 1;
+    constexpr uint16_t kRelaIndex = 2;
+    constexpr uint16_t kSymtabIndex = 3;
+    constexpr uint16_t kStrtabIndex = 4;
+    constexpr uint16_t kShstrtabIndex = 5;
+    constexpr uint16_t kSectionCount = 6;
+
+    // ------------------------------------------------------------------
+    // Build the symbol table: null, .text section symbol, then globals
+    // (defined functions first, then undefined externals referenced by
+    // relocations). Locals must precede globals per the ELF spec.
+    // ------------------------------------------------------------------
+    StringTable strtab;
+    std::vector<Elf64_Sym> symbols;
+
+    Elf64_Sym nullSym;
+    std::memset(&nullSym, 0, sizeof(nullSym));
+    symbols.push_back(nullSym);
+
+    Elf64_Sym textSym;
+    std::memset(&textSym, 0, sizeof(textSym));
+    textSym.st_info = symInfo(STB_LOCAL, STT_SECTION);
+    textSym.st_shndx = kTextIndex;
+    symbols.push_back(textSym);
+
+    std::map<std::string, uint32_t> symbolIndex; // name -> symtab index
+    for (const Symbol& function : functions_) {
+        Elf64_Sym sym;
+        std::memset(&sym, 0, sizeof(sym));
+        sym.st_name = strtab.add(function.name);
+        sym.st_info = symInfo(STB_GLOBAL, STT_FUNC);
+        sym.st_shndx = kTextIndex;
+        sym.st_value = function.offset;
+        sym.st_size = function.size;
+        symbolIndex[function.name] = static_cast<uint32_t>(symbols.size());
+        symbols.push_back(sym);
+    }
+    for (const Relocation& reloc : relocations_) {
+        if (symbolIndex.count(reloc.symbol) != 0) {
+            continue;
+        }
+        Elf64_Sym sym; // Undefined external (e.g. a libc function)
+        std::memset(&sym, 0, sizeof(sym));
+        sym.st_name = strtab.add(reloc.symbol);
+        sym.st_info = symInfo(STB_GLOBAL, STT_NOTYPE);
+        symbolIndex[reloc.symbol] = static_cast<uint32_t>(symbols.size());
+        symbols.push_back(sym);
+    }
+
+    std::vector<Elf64_Rela> relas;
+    relas.reserve(relocations_.size());
+    for (const Relocation& reloc : relocations_) {
+        Elf64_Rela rela;
+        rela.r_offset = reloc.offset;
+        rela.r_info = (static_cast<uint64_t>(symbolIndex[reloc.symbol]) << 32) |
+                      R_X86_64_PLT32;
+        rela.r_addend = -4; // rel32 is relative to the end of the call
+        relas.push_back(rela);
+    }
+
+    // ------------------------------------------------------------------
+    // Lay out the file: header, section bodies, section header table.
+    // ------------------------------------------------------------------
+    StringTable shstrtab;
+    uint32_t nameText = shstrtab.add(".text");
+    uint32_t nameRela = shstrtab.add(".rela.text");
+    uint32_t nameSymtab = shstrtab.add(".symtab");
+    uint32_t nameStrtab = shstrtab.add(".strtab");
+    uint32_t nameShstrtab = shstrtab.add(".shstrtab");
+
+    auto align8 = [](uint64_t offset) { return (offset + 7) & ~uint64_t(7); };
+
+    uint64_t offset = sizeof(Elf64_Ehdr);
+    uint64_t textOffset = align8(offset);
+    offset = textOffset + text_.size();
+    uint64_t relaOffset = align8(offset);
+    offset = relaOffset + relas.size() * sizeof(Elf64_Rela);
+    uint64_t symtabOffset = align8(offset);
+    offset = symtabOffset + symbols.size() * sizeof(Elf64_Sym);
+    uint64_t strtabOffset = offset;
+    offset += strtab.data().size();
+    uint64_t shstrtabOffset = offset;
+    offset += shstrtab.data().size();
+    uint64_t shoff = align8(offset);
+
+    Elf64_Ehdr ehdr;
+    std::memset(&ehdr, 0, sizeof(ehdr));
+    ehdr.e_ident[0] = 0x7F;
+    ehdr.e_ident[1] = 'E';
+    ehdr.e_ident[2] = 'L';
+    ehdr.e_ident[3] = 'F';
+    ehdr.e_ident[4] = 2; // ELFCLASS64
+    ehdr.e_ident[5] = 1; // ELFDATA2LSB
+    ehdr.e_ident[6] = 1; // EV_CURRENT
+    ehdr.e_type = ET_REL;
+    ehdr.e_machine = EM_X86_64;
+    ehdr.e_version = 1;
+    ehdr.e_shoff = shoff;
+    ehdr.e_ehsize = sizeof(Elf64_Ehdr);
+    ehdr.e_shentsize = sizeof(Elf64_Shdr);
+    ehdr.e_shnum = kSectionCount;
+    ehdr.e_shstrndx = kShstrtabIndex;
+
+    Elf64_Shdr sections[kSectionCount];
+    std::memset(sections, 0, sizeof(sections));
+
+    sections[kTextIndex].sh_name = nameText;
+    sections[kTextIndex].sh_type = SHT_PROGBITS;
+    sections[kTextIndex].sh_flags = SHF_ALLOC | SHF_EXECINSTR;
+    sections[kTextIndex].sh_offset = textOffset;
+    sections[kTextIndex].sh_size = text_.size();
+    sections[kTextIndex].sh_addralign = 16;
+
+    sections[kRelaIndex].sh_name = nameRela;
+    sections[kRelaIndex].sh_type = SHT_RELA;
+    sections[kRelaIndex].sh_flags = SHF_INFO_LINK;
+    sections[kRelaIndex].sh_offset = relaOffset;
+    sections[kRelaIndex].sh_size = relas.size() * sizeof(Elf64_Rela);
+    sections[kRelaIndex].sh_link = kSymtabIndex;
+    sections[kRelaIndex].sh_info = kTextIndex;
+    sections[kRelaIndex].sh_addralign = 8;
+    sections[kRelaIndex].sh_entsize = sizeof(Elf64_Rela);
+
+    sections[kSymtabIndex].sh_name = nameSymtab;
+    sections[kSymtabIndex].sh_type = SHT_SYMTAB;
+    sections[kSymtabIndex].sh_offset = symtabOffset;
+    sections[kSymtabIndex].sh_size = symbols.size() * sizeof(Elf64_Sym);
+    sections[kSymtabIndex].sh_link = kStrtabIndex;
+    sections[kSymtabIndex].sh_info = 2; // First global symbol index
+    sections[kSymtabIndex].sh_addralign = 8;
+    sections[kSymtabIndex].sh_entsize = sizeof(Elf64_Sym);
+
+    sections[kStrtabIndex].sh_name = nameStrtab;
+    sections[kStrtabIndex].sh_type = SHT_STRTAB;
+    sections[kStrtabIndex].sh_offset = strtabOffset;
+    sections[kStrtabIndex].sh_size = strtab.data().size();
+    sections[kStrtabIndex].sh_addralign = 1;
+
+    sections[kShstrtabIndex].sh_name = nameShstrtab;
+    sections[kShstrtabIndex].sh_type = SHT_STRTAB;
+    sections[kShstrtabIndex].sh_offset = shstrtabOffset;
+    sections[kShstrtabIndex].sh_size = shstrtab.data().size();
+    sections[kShstrtabIndex].sh_addralign = 1;
+
+    // ------------------------------------------------------------------
+    // Emit
+    // ------------------------------------------------------------------
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        return false;
+    }
+
+    auto writeBytes = [&](const void* data, size_t size) {
+        out.write(static_cast<const char*>(data),
+                  static_cast<std::streamsize>(size));
+    };
+    auto padTo = [&](uint64_t target) {
+        static const char zeros[8] = {0};
+        uint64_t current = static_cast<uint64_t>(out.tellp());
+        if (target > current) {
+            writeBytes(zeros, target - current);
+        }
+    };
+
+    writeBytes(&ehdr, sizeof(ehdr));
+    padTo(textOffset);
+    if (!text_.empty()) {
+        writeBytes(text_.data(), text_.size());
+    }
+    padTo(relaOffset);
+    if (!relas.empty()) {
+        writeBytes(relas.data(), relas.size() * sizeof(Elf64_Rela));
+    }
+    padTo(symtabOffset);
+    writeBytes(symbols.data(), symbols.size() * sizeof(Elf64_Sym));
+    writeBytes(strtab.data().data(), strtab.data().size());
+    writeBytes(shstrtab.data().data(), shstrtab.data().size());
+    padTo(shoff);
+    writeBytes(sections, sizeof(sections));
+
+    return out.good();
+}
@@ -0,0 +1,146 @@
+#include "compile_server.h"
+
+#include "third_party/json.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#ifndef _WIN32
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using json = nlohmann::json;
+
+CompileServer::CompileServer(const std::string& socketPath)
+    : socketPath_(socketPath) {}
+
+// Run the full dump-producing pipeline in-process for one request.
+// Diagnostics are buffered per request (never interleaved on the daemon's
+// stderr) and returned to the client.
+std::string CompileServer::handleRequest(const std::string& requestJson)
+{
+    json response;
+    response["success"] = false;
+
+    std::string source;
+    std::string filename = "input.c";
+    try {
+        json request = json::parse(requestJson);
+        if (!request.contains("source") || !request["source"].is_string()) {
+            response["error"] = "Missing \"source\" field";
+            return response.dump();
+        }
+        source = request["source"].get<std::string>();
+        if (request.contains("filename") && request["filename"].is_string()) {
+            filename = request["filename"].get<std::string>();
+        }
+    } catch (const std::exception& e) {
+        response["error"] = std::string("Invalid JSON request: ") + e.what();
+        return response.dump();
+    }
+
+    // Run the driver's incremental pipeline: unchanged functions reuse
+    // their cached optimized IR from the previous request on this daemon.
+    CompilerDriver::VisualizationResult result =
+        driver_.compileForVisualization(source, filename);
+
+    try {
+        if (!result.tokensJson.empty()) {
+            response["tokens"] = json::parse(result.tokensJson);
+        }
+        if (!result.astJson.empty()) {
+            response["ast"] = json::parse(result.astJson);
+        }
+    } catch (const std::exception& e) {
+        response["error"] = std::string("Internal error: ") + e.what();
+        return response.dump();
+    }
+
+    response["success"] = result.success;
+    response["stderr"] = result.diagnostics;
+    if (result.success) {
+        response["assembly"] = result.assembly;
+    } else {
+        response["error"] = result.error;
+    }
+
+    return response.dump();
+}
+
+int CompileServer::run()
+{
+#ifdef _WIN32
+    std::cerr << "Error: daemon mode requires Unix domain sockets"
+              << std::endl;
+    return 1;
+#else
+    // A client that disconnects before reading its response (the Flask
+    // bridge does exactly this on its socket timeout) would otherwise
+    // raise SIGPIPE on our write() and kill the whole daemon; ignore it
+    // and let write() return EPIPE for that one connection instead.
+    signal(SIGPIPE, SIG_IGN);
+
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        std::cerr << "Error: cannot create socket" << std::endl;
+        return 1;
+    }
+
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (socketPath_.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Error: socket path too long: " << socketPath_
+                  << std::endl;
+        return 1;
+    }
+    std::strncpy(addr.sun_path, socketPath_.c_str(),
+                 sizeof(addr.sun_path) - 1);
+
+    unlink(socketPath_.c_str()); // Replace a stale socket from a dead daemon
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        std::cerr << "Error: cannot bind socket: " << socketPath_ << std::endl;
+        close(listenFd);
+        return 1;
+    }
+    if (listen(listenFd, 64) != 0) {
+        std::cerr << "Error: cannot listen on socket" << std::endl;
+        close(listenFd);
+        return 1;
+    }
+
+    std::cout << "mycc daemon listening on " << socketPath_ << std::endl;
+
+    while (true) {
+        int clientFd = accept(listenFd, nullptr, nullptr);
+        if (clientFd < 0) {
+            continue;
+        }
+
+        // Read the request to EOF (client half-closes after sending)
+        std::string request;
+        char buffer[4096];
+        ssize_t n;
+        while ((n = read(clientFd, buffer, sizeof(buffer))) > 0) {
+            request.append(buffer, static_cast<size_t>(n));
+        }
+
+        std::string response = handleRequest(request);
+
+        size_t written = 0;
+        while (written < response.size()) {
+            ssize_t w = write(clientFd, response.data() + written,
+                              response.size() - written);
+            if (w <= 0) {
+                break;
+            }
+            written += static_cast<size_t>(w);
+        }
+        close(clientFd);
+    }
+#endif
+}
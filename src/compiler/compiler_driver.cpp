@@ -1,17 +1,24 @@
 #include "compiler_driver.h"
 #include "codegen.h"
+#include "direct_obj_emitter.h"
+#include "source_buffer.h"
 #include "ir_codegen.h"
 #include "ir_optimizer.h"
 #include "json_serializers.h"
 #include "lexer.h"
 #include "parser.h"
 #include "semantic_analyzer.h"
+#include <atomic>
+#include <chrono>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <thread>
 
 #ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/resource.h>
 #include <sys/stat.h>
 #include <sys/wait.h>
 #include <unistd.h>
@@ -23,6 +30,296 @@
 
 #endif
 
+// ============================================================================
+// AST Fingerprinting (for incremental recompilation)
+// ============================================================================
+// Hashes a declaration's structure, names, operators and literal values,
+// deliberately ignoring source locations: editing one function shifts the
+// line numbers of everything below it, and that must not look like a
+// change. FNV-1a over a pre-order walk.
+namespace {
+
+class ASTFingerprintVisitor : public ASTVisitor {
+public:
+  uint64_t hash = 14695981039346656037ULL; // FNV offset basis
+
+  static uint64_t fingerprintOf(ASTNode *node) {
+    ASTFingerprintVisitor visitor;
+    visitor.child(node);
+    return visitor.hash;
+  }
+
+  void visit(BinaryExpr &node) override {
+    tag(1);
+    str(node.getOperator());
+    child(node.getLeft());
+    child(node.getRight());
+  }
+  void visit(UnaryExpr &node) override {
+    tag(2);
+    str(node.getOperator());
+    mix(node.isPrefixOp());
+    child(node.getOperand());
+  }
+  void visit(LiteralExpr &node) override {
+    tag(3);
+    mix(static_cast<uint64_t>(node.getLiteralType()));
+    str(node.getValue());
+  }
+  void visit(IdentifierExpr &node) override {
+    tag(4);
+    str(node.getName());
+  }
+  void visit(CallExpr &node) override {
+    tag(5);
+    child(node.getCallee());
+    mix(node.getArguments().size());
+    for (auto *arg : node.getArguments()) {
+      child(arg);
+    }
+  }
+  void visit(AssignmentExpr &node) override {
+    tag(6);
+    child(node.getTarget());
+    child(node.getValue());
+  }
+  void visit(ArrayAccessExpr &node) override {
+    tag(7);
+    child(node.getArray());
+    child(node.getIndex());
+  }
+  void visit(MemberAccessExpr &node) override {
+    tag(8);
+    str(node.getMemberName());
+    mix(node.getIsArrow());
+    child(node.getObject());
+  }
+  void visit(TypeCastExpr &node) override {
+    tag(9);
+    str(node.getTargetType());
+    mix(node.getIsImplicit());
+    child(node.getOperand());
+  }
+  void visit(TernaryExpr &node) override {
+    tag(10);
+    child(node.getCondition());
+    child(node.getTrueExpr());
+    child(node.getFalseExpr());
+  }
+  void visit(SizeOfExpr &node) override {
+    tag(11);
+    str(node.getTargetType());
+    child(node.getOperand());
+  }
+  void visit(IfStmt &node) override {
+    tag(12);
+    child(node.getCondition());
+    child(node.getThenBranch());
+    child(node.getElseBranch());
+  }
+  void visit(WhileStmt &node) override {
+    tag(13);
+    child(node.getCondition());
+    child(node.getBody());
+  }
+  void visit(ForStmt &node) override {
+    tag(14);
+    child(node.getInitializer());
+    child(node.getCondition());
+    child(node.getIncrement());
+    child(node.getBody());
+  }
+  void visit(ReturnStmt &node) override {
+    tag(15);
+    child(node.getReturnValue());
+  }
+  void visit(CompoundStmt &node) override {
+    tag(16);
+    mix(node.getStatements().size());
+    for (auto *stmt : node.getStatements()) {
+      child(stmt);
+    }
+  }
+  void visit(ExpressionStmt &node) override {
+    tag(17);
+    child(node.getExpression());
+  }
+  void visit(DeclStmt &node) override {
+    tag(18);
+    child(node.getDeclaration());
+  }
+  void visit(BreakStmt &) override { tag(19); }
+  void visit(ContinueStmt &) override { tag(20); }
+  void visit(VarDecl &node) override {
+    tag(21);
+    str(node.getName());
+    str(node.getType());
+    mix(node.getIsArray());
+    mix(static_cast<uint64_t>(node.getPointerLevel()));
+    child(node.getInitializer());
+    child(node.getArraySize());
+  }
+  void visit(TypeDecl &node) override {
+    tag(22);
+    str(node.getName());
+    str(node.getUnderlyingType());
+  }
+  void visit(StructDecl &node) override {
+    tag(23);
+    str(node.getName());
+    mix(node.getFields().size());
+    for (auto *field : node.getFields()) {
+      child(field);
+    }
+  }
+  void visit(FunctionDecl &node) override {
+    tag(24);
+    str(node.getName());
+    str(node.getReturnType());
+    mix(node.getIsExtern());
+    mix(node.getParameters().size());
+    for (auto *param : node.getParameters()) {
+      child(param);
+    }
+    child(node.getBody());
+  }
+  void visit(ParameterDecl &node) override {
+    tag(25);
+    str(node.getName());
+    str(node.getType());
+  }
+
+  void mix(uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+      hash ^= (value >> (i * 8)) & 0xFF;
+      hash *= 1099511628211ULL; // FNV prime
+    }
+  }
+  void str(const std::string &text) {
+    for (unsigned char c : text) {
+      hash ^= c;
+      hash *= 1099511628211ULL;
+    }
+    mix(text.size());
+  }
+
+private:
+  void tag(uint64_t node_tag) { mix(node_tag); }
+  void child(ASTNode *node) {
+    if (node == nullptr) {
+      mix(0xFFFFFFFFFFFFFFFFULL); // Distinguish "no child" from any child
+      return;
+    }
+    node->accept(*this);
+  }
+};
+
+// Hash of everything that can change the meaning of an arbitrary function
+// body: globals, structs, typedefs, and every function's signature. If this
+// seed changes, nothing in the cache can be trusted.
+uint64_t globalContextFingerprint(const std::vector<Declaration *> &ast) {
+  ASTFingerprintVisitor visitor;
+  for (Declaration *decl : ast) {
+    if (auto *funcDecl = dynamic_cast<FunctionDecl *>(decl)) {
+      // Signature only: the body is fingerprinted per function
+      visitor.str(funcDecl->getName());
+      visitor.str(funcDecl->getReturnType());
+      visitor.mix(funcDecl->getParameters().size());
+      for (auto *param : funcDecl->getParameters()) {
+        visitor.str(param->getName());
+        visitor.str(param->getType());
+      }
+    } else {
+      decl->accept(visitor);
+    }
+  }
+  return visitor.hash;
+}
+
+} // namespace
+
+// ============================================================================
+// Phase Timing Report (for --dump-timing)
+// ============================================================================
+// Collects per-phase wall times and memory statistics during compile() and
+// writes them as JSON when destroyed, so every return path (success or
+// error) still produces the report.
+namespace {
+
+class PhaseTimingReport {
+public:
+  explicit PhaseTimingReport(const std::string &path) : path_(path) {
+    last_ = std::chrono::steady_clock::now();
+  }
+
+  // Restart the phase clock (call right before a phase begins, so time
+  // spent writing dumps between phases is not charged to the next phase).
+  void start() { last_ = std::chrono::steady_clock::now(); }
+
+  // Record the time since the last start()/mark() under `phase`.
+  void mark(const std::string &phase) {
+    auto now = std::chrono::steady_clock::now();
+    if (!path_.empty()) {
+      long long us =
+          std::chrono::duration_cast<std::chrono::microseconds>(now - last_)
+              .count();
+      phases_.push_back({phase, us});
+    }
+    last_ = now;
+  }
+
+  void setMemoryStat(const std::string &name, long long value) {
+    memory_.push_back({name, value});
+  }
+
+  // Raw JSON array from PassManager::statisticsToJson()
+  void setOptimizerStats(std::string statsJson) {
+    optimizerStats_ = std::move(statsJson);
+  }
+
+  ~PhaseTimingReport() {
+    if (path_.empty()) {
+      return;
+    }
+    std::ofstream out(path_);
+    if (!out) {
+      return;
+    }
+    out << "{\n  \"phases\": [\n";
+    for (size_t i = 0; i < phases_.size(); ++i) {
+      out << "    {\"phase\": \"" << phases_[i].first
+          << "\", \"wall_time_us\": " << phases_[i].second << "}"
+          << (i + 1 < phases_.size() ? "," : "") << "\n";
+    }
+    out << "  ],\n";
+    if (!optimizerStats_.empty()) {
+      out << "  \"optimizer_passes\": " << optimizerStats_ << ",\n";
+    }
+    out << "  \"memory\": {\n";
+    long long peakRssKb = 0;
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+      peakRssKb = usage.ru_maxrss;
+    }
+#endif
+    out << "    \"peak_rss_kb\": " << peakRssKb;
+    for (const auto &stat : memory_) {
+      out << ",\n    \"" << stat.first << "\": " << stat.second;
+    }
+    out << "\n  }\n}\n";
+  }
+
+private:
+  std::string path_;
+  std::chrono::steady_clock::time_point last_;
+  std::vector<std::pair<std::string, long long>> phases_;
+  std::vector<std::pair<std::string, long long>> memory_;
+  std::string optimizerStats_;
+};
+
+} // namespace
+
 // ============================================================================
 // Compiler Driver Implementation
 // ============================================================================
@@ -127,6 +424,153 @@ bool CompilerDriver::runCommand(const std::string &command,
   return true;
 }
 
+// Run argv with optional stdin data, capturing combined stdout/stderr
+// through pipes (no shell, no files). Returns true when the child exits 0.
+bool CompilerDriver::runPipedCommand(const std::vector<std::string> &argv,
+                                     const std::string *stdinData,
+                                     std::string &output) {
+#ifdef _WIN32
+  (void)argv;
+  (void)stdinData;
+  (void)output;
+  return false; // Piped backend is POSIX-only
+#else
+  int inPipe[2] = {-1, -1};
+  int outPipe[2] = {-1, -1};
+  if (pipe(inPipe) != 0 || pipe(outPipe) != 0) {
+    return false;
+  }
+
+  pid_t pid = fork();
+  if (pid < 0) {
+    return false;
+  }
+
+  if (pid == 0) {
+    // Child: stdin from inPipe, stdout+stderr into outPipe
+    dup2(inPipe[0], 0);
+    dup2(outPipe[1], 1);
+    dup2(outPipe[1], 2);
+    close(inPipe[0]);
+    close(inPipe[1]);
+    close(outPipe[0]);
+    close(outPipe[1]);
+
+    std::vector<char *> args;
+    args.reserve(argv.size() + 1);
+    for (const auto &arg : argv) {
+      args.push_back(const_cast<char *>(arg.c_str()));
+    }
+    args.push_back(nullptr);
+    execvp(args[0], args.data());
+    _exit(127);
+  }
+
+  // Parent: feed stdin, then collect output
+  close(inPipe[0]);
+  close(outPipe[1]);
+  if (stdinData != nullptr && !stdinData->empty()) {
+    size_t written = 0;
+    while (written < stdinData->size()) {
+      ssize_t n = ::write(inPipe[1], stdinData->data() + written,
+                          stdinData->size() - written);
+      if (n <= 0) {
+        break;
+      }
+      written += static_cast<size_t>(n);
+    }
+  }
+  close(inPipe[1]);
+
+  output.clear();
+  char buffer[4096];
+  ssize_t n;
+  while ((n = ::read(outPipe[0], buffer, sizeof(buffer))) > 0) {
+    output.append(buffer, static_cast<size_t>(n));
+  }
+  close(outPipe[0]);
+
+  int status = 0;
+  waitpid(pid, &status, 0);
+  return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+#endif
+}
+
+// Zero-temp-file backend: `as` reads the assembly from a pipe and writes
+// the object into a memfd; the linker then reads that same memfd through
+// /proc/self/fd. Nothing lands on the (overlayfs) filesystem except the
+// final output.
+bool CompilerDriver::assembleAndLinkInMemory(const std::string &assembly,
+                                             const std::string &sourceName) {
+#ifdef _WIN32
+  (void)assembly;
+  (void)sourceName;
+  reportError("--no-temp-files is not supported on this platform");
+  return false;
+#else
+  (void)sourceName;
+
+  int objFd = memfd_create("mycc-obj", 0); // Inheritable on purpose
+  if (objFd < 0) {
+    reportError("memfd_create failed; rerun without --no-temp-files");
+    return false;
+  }
+  std::string objPath = "/proc/self/fd/" + std::to_string(objFd);
+
+  // Assemble: stdin -> as -> memfd
+  std::string output;
+  if (!runPipedCommand({"as", "-o", objPath, "-"}, &assembly, output)) {
+    reportError("Assembly failed");
+    if (!output.empty()) {
+      std::cerr << output << std::endl;
+    }
+    close(objFd);
+    return false;
+  }
+  reportInfo("Assembled " + std::to_string(assembly.size()) +
+             " bytes of assembly in memory");
+
+  if (options.emitObject) {
+    // -c: the final object is the one artifact that must become a file
+    std::ifstream in(objPath, std::ios::binary);
+    std::ofstream out(options.outputFile, std::ios::binary);
+    if (!in || !out) {
+      reportError("Failed to write object file: " + options.outputFile);
+      close(objFd);
+      return false;
+    }
+    out << in.rdbuf();
+    close(objFd);
+    reportInfo("Object file written: " + options.outputFile);
+    return true;
+  }
+
+  // Link straight from the memfd
+  std::vector<std::string> linkArgv;
+  if (options.linkWithCRT) {
+    linkArgv = {"gcc", "-o", options.outputFile, objPath};
+  } else {
+    linkArgv = {"ld", "-o", options.outputFile, "-e", "_start", objPath};
+  }
+  for (const auto &lib : options.linkLibraries) {
+    linkArgv.push_back("-l" + lib);
+  }
+
+  if (!runPipedCommand(linkArgv, nullptr, output)) {
+    reportError("Linking failed");
+    if (!output.empty()) {
+      std::cerr << output << std::endl;
+    }
+    close(objFd);
+    return false;
+  }
+  close(objFd);
+  chmod(options.outputFile.c_str(), 0755);
+  reportInfo("Linked in-memory object -> " + options.outputFile);
+  return true;
+#endif
+}
+
 bool CompilerDriver::writeAssemblyFile(const std::string &assembly,
                                        const std::string &filename) {
   reportInfo("Writing assembly to: " + filename);
@@ -196,6 +640,12 @@ bool CompilerDriver::linkFiles(const std::vector<std::string> &objFiles,
     // Use ld directly
     cmd << "ld -o " << executable << " ";
     cmd << "-e _start ";
+    // Standalone executables need the _start shim; link the cached
+    // pre-assembled object instead of assembling it per compile
+    std::string startupObj = getStartupObject();
+    if (!startupObj.empty()) {
+      cmd << startupObj << " ";
+    }
   }
 #endif
 
@@ -235,7 +685,259 @@ void CompilerDriver::cleanup(const std::vector<std::string> &files) {
   }
 }
 
-bool CompilerDriver::compile(const std::string &sourceCode,
+// Out-of-line so unique_ptr<IRFunction> in the cache sees a complete type
+CompilerDriver::~CompilerDriver() = default;
+
+void CompilerDriver::clearIncrementalCache() { functionCache_.clear(); }
+
+// Shared incremental core. Fingerprints are seeded with the global
+// context, so edits to globals/structs/signatures invalidate all bodies
+// at once; unchanged functions reuse the cached optimized IR and changed
+// ones are regenerated and re-optimized. Functions deleted from the
+// source simply don't make it into the new cache.
+bool CompilerDriver::regenerateChangedFunctions(
+    const std::vector<Declaration *> &ast, IRCodeGenerator &irCodeGen,
+    std::vector<IRFunction *> &out, size_t &reusedCount, std::string &error) {
+  uint64_t contextSeed = globalContextFingerprint(ast);
+
+  std::unordered_map<std::string, CachedFunction> newCache;
+  reusedCount = 0;
+
+  for (const auto &decl : ast) {
+    auto *funcDecl = dynamic_cast<FunctionDecl *>(decl);
+    if (funcDecl == nullptr || funcDecl->getBody() == nullptr) {
+      continue;
+    }
+
+    uint64_t fingerprint =
+        contextSeed ^ ASTFingerprintVisitor::fingerprintOf(funcDecl);
+
+    auto cached = functionCache_.find(funcDecl->getName());
+    if (cached != functionCache_.end() &&
+        cached->second.fingerprint == fingerprint) {
+      // Unchanged: reuse the optimized IR from the previous compile
+      newCache[funcDecl->getName()] = std::move(cached->second);
+      reusedCount++;
+    } else {
+      try {
+        auto irFunc = irCodeGen.generateFunctionIR(funcDecl);
+        if (!irFunc) {
+          continue;
+        }
+        if (options.optimize) {
+          IROptimizer optimizer;
+          optimizer.optimize(irFunc.get());
+        }
+        newCache[funcDecl->getName()] = {fingerprint, std::move(irFunc)};
+      } catch (const std::exception &e) {
+        error = "IR generation failed for function '" + funcDecl->getName() +
+                "': " + e.what();
+        return false;
+      }
+    }
+    out.push_back(newCache[funcDecl->getName()].ir.get());
+  }
+
+  functionCache_ = std::move(newCache);
+  return true;
+}
+
+// In-memory incremental pipeline for the visualization edit loop: the
+// compile daemon holds one CompilerDriver and calls this per request, so
+// a keystroke edit of one function body pays IR generation and
+// optimization for that function only. Diagnostics are buffered and no
+// files are written.
+CompilerDriver::VisualizationResult
+CompilerDriver::compileForVisualization(std::string_view sourceCode,
+                                        const std::string &sourceName) {
+  VisualizationResult result;
+  std::ostringstream diagnostics;
+
+  // Half-typed source is this path's normal diet (keystroke-triggered
+  // requests), and the parser throws on some incomplete inputs. Nothing
+  // may escape: an exception becomes an error response, never a dead
+  // daemon (mirrors compileToObject's worker-thread guard).
+  try {
+    Lexer lexer(sourceCode, sourceName);
+    lexer.getErrorHandler().set_output_stream(&diagnostics);
+    std::vector<Token> tokens = lexer.lexAll();
+    result.tokensJson = serializeTokensToJson(tokens);
+    lexer.reset();
+
+    Parser parser(lexer);
+    parser.getErrorHandler().set_output_stream(&diagnostics);
+    auto ast = parser.parseProgram();
+    if (parser.hasErrors() || lexer.hasErrors()) {
+      result.error = "Parsing failed";
+      result.diagnostics = diagnostics.str();
+      return result;
+    }
+    result.astJson = serializeAstToJson(ast);
+
+    SemanticAnalyzer semanticAnalyzer;
+    semanticAnalyzer.getErrorHandler().set_output_stream(&diagnostics);
+    semanticAnalyzer.set_arena(&parser.getArena());
+    semanticAnalyzer.set_warnings_enabled(options.warningsEnabled);
+    semanticAnalyzer.analyze_program(ast);
+    if (semanticAnalyzer.has_errors()) {
+      result.error = "Semantic analysis failed";
+      result.diagnostics = diagnostics.str();
+      return result;
+    }
+
+    IRCodeGenerator irCodeGen;
+    irCodeGen.setTypeMaps(semanticAnalyzer.get_expression_types(),
+                          semanticAnalyzer.get_struct_types());
+    std::vector<IRFunction *> irFunctions;
+    size_t reusedCount = 0;
+    if (!regenerateChangedFunctions(ast, irCodeGen, irFunctions, reusedCount,
+                                    result.error)) {
+      result.diagnostics = diagnostics.str();
+      return result;
+    }
+    reportInfo("Visualization compile: " + std::to_string(reusedCount) +
+               " reused, " +
+               std::to_string(irFunctions.size() - reusedCount) +
+               " recompiled function(s)");
+
+    CodeGenerator codeGen;
+    codeGen.setSourceFile(sourceName);
+    codeGen.setRegisterAllocationMode(options.regalloc);
+    result.assembly = codeGen.generateProgram(irFunctions);
+
+      result.success = true;
+      result.diagnostics = diagnostics.str();
+  } catch (const std::exception &e) {
+    result.success = false;
+    result.error = std::string("Internal error: ") + e.what();
+    result.diagnostics = diagnostics.str();
+  }
+  return result;
+}
+// Incremental recompile: re-lex and re-parse (cheap, and required to diff),
+// run whole-program semantic analysis (function bodies need global types),
+// but regenerate and re-optimize IR only for functions whose fingerprint
+// changed. Unchanged functions reuse the optimized IR cached by the
+// previous call; codegen still runs over the full set so labels and the
+// data section stay consistent.
+bool CompilerDriver::compileIncremental(std::string_view sourceCode,
+                                        const std::string &sourceName) {
+  errorCount = 0;
+
+  // Same guard as the visualization path: incomplete input can make the
+  // parser throw, and this entry point must fail the compile, not the
+  // process.
+  try {
+    Lexer lexer(sourceCode, sourceName);
+    Parser parser(lexer);
+    auto ast = parser.parseProgram();
+    if (parser.hasErrors() || lexer.hasErrors()) {
+      reportError("Parsing failed");
+      return false;
+    }
+
+    SemanticAnalyzer semanticAnalyzer;
+    semanticAnalyzer.set_arena(&parser.getArena());
+    semanticAnalyzer.set_warnings_enabled(options.warningsEnabled);
+    semanticAnalyzer.analyze_program(ast);
+    if (semanticAnalyzer.has_errors()) {
+      reportError("Semantic analysis failed");
+      return false;
+    }
+
+    IRCodeGenerator irCodeGen;
+    irCodeGen.setTypeMaps(semanticAnalyzer.get_expression_types(),
+                          semanticAnalyzer.get_struct_types());
+
+    std::vector<IRFunction *> irFunctions;
+    size_t reusedCount = 0;
+    std::string irError;
+    if (!regenerateChangedFunctions(ast, irCodeGen, irFunctions, reusedCount,
+                                    irError)) {
+      reportError(irError);
+      return false;
+    }
+
+    reportInfo("Incremental compile: " + std::to_string(reusedCount) +
+               " reused, " +
+               std::to_string(irFunctions.size() - reusedCount) +
+               " recompiled function(s)");
+
+    CodeGenerator codeGen;
+    codeGen.setSourceFile(sourceName);
+    codeGen.setRegisterAllocationMode(options.regalloc);
+    std::string assembly = codeGen.generateProgram(irFunctions);
+
+    // Honor the visualization dumps like compile() does
+    if (!options.dumpTokensPath.empty()) {
+      Lexer dumpLexer(sourceCode, sourceName);
+      std::ofstream outFile(options.dumpTokensPath);
+      if (outFile) {
+        outFile << serializeTokensToJson(dumpLexer.lexAll());
+      }
+    }
+    if (!options.dumpAstPath.empty()) {
+      std::ofstream outFile(options.dumpAstPath);
+      if (outFile) {
+        outFile << serializeAstToJson(ast);
+      }
+    }
+    if (!options.dumpAsmPath.empty()) {
+      std::ofstream outFile(options.dumpAsmPath);
+      if (outFile) {
+        outFile << assembly;
+      }
+    }
+
+    std::string asmFile = getTempFileName(sourceName, ".s");
+    if (options.emitAssembly) {
+      asmFile = options.outputFile;
+    }
+    if (!writeAssemblyFile(assembly, asmFile)) {
+      return false;
+    }
+    if (options.emitAssembly) {
+      return true;
+    }
+
+    std::string objFile = getTempFileName(sourceName, ".o");
+    if (options.emitObject) {
+      objFile = options.outputFile;
+    }
+    if (!assembleFile(asmFile, objFile)) {
+      return false;
+    }
+    if (options.emitObject) {
+      cleanup({asmFile});
+      return true;
+    }
+
+    if (!linkFiles({objFile}, options.outputFile)) {
+      return false;
+    }
+  #ifndef _WIN32
+    chmod(options.outputFile.c_str(), 0755);
+  #endif
+    cleanup({asmFile, objFile});
+    return true;
+  } catch (const std::exception &e) {
+    reportError(std::string("Internal error: ") + e.what());
+    return false;
+  }
+}
+
+bool CompilerDriver::compileFile(const std::string &sourcePath) {
+  SourceBuffer buffer;
+  if (!buffer.loadFile(sourcePath)) {
+    reportError(buffer.getError());
+    return false;
+  }
+  // The buffer outlives the whole pipeline below, so the lexer can scan
+  // the mapping directly.
+  return compile(buffer.view(), sourcePath);
+}
+
+bool CompilerDriver::compile(std::string_view sourceCode,
                              const std::string &sourceName) {
   errorCount = 0;
 
@@ -246,13 +948,18 @@ bool CompilerDriver::compile(const std::string &sourceCode,
   reportInfo("Output: " + options.outputFile);
   reportInfo("");
 
+  // Written on destruction, so early error returns still dump timing
+  PhaseTimingReport timing(options.dumpTimingPath);
+
   // ========================================================================
   // Stage 1: Lexical Analysis
   // ========================================================================
   reportInfo("Stage 1: Lexical Analysis");
 
+  timing.start();
   Lexer lexer(sourceCode, sourceName);
   std::vector<Token> tokens = lexer.lexAll();
+  timing.mark("lex");
 
   if (tokens.empty() || tokens.back().type != TokenType::EOF_TOKEN) {
     reportError("Lexical analysis failed");
@@ -280,6 +987,21 @@ bool CompilerDriver::compile(const std::string &sourceCode,
     }
   }
 
+  // Dump tokens in the binary MTK1 format if requested
+  if (!options.dumpTokensBinPath.empty()) {
+    reportInfo("  -> Dumping binary tokens to: " + options.dumpTokensBinPath);
+    std::ofstream outFile(options.dumpTokensBinPath, std::ios::binary);
+    if (!outFile) {
+      reportError("Failed to open file for writing: " +
+                  options.dumpTokensBinPath);
+    } else {
+      std::string binary = serializeTokensToBinary(tokens);
+      outFile.write(binary.data(), static_cast<std::streamsize>(binary.size()));
+      reportInfo("  -> Binary token dump successful (" +
+                 std::to_string(binary.size()) + " bytes)");
+    }
+  }
+
   // ========================================================================
   // Stage 2: Parsing
   // ========================================================================
@@ -288,8 +1010,14 @@ bool CompilerDriver::compile(const std::string &sourceCode,
   // Reset lexer position after lexAll() consumed all tokens
   lexer.reset();
 
+  timing.start();
   Parser parser(lexer);
   auto ast = parser.parseProgram();
+  timing.mark("parse");
+  timing.setMemoryStat("ast_arena_bytes",
+                       static_cast<long long>(parser.getArena().bytesAllocated()));
+  timing.setMemoryStat("ast_arena_slabs",
+                       static_cast<long long>(parser.getArena().slabCount()));
 
   if (parser.hasErrors()) {
     reportError("Parsing failed");
@@ -323,9 +1051,12 @@ bool CompilerDriver::compile(const std::string &sourceCode,
   // ========================================================================
   reportInfo("Stage 3: Semantic Analysis");
 
+  timing.start();
   SemanticAnalyzer semanticAnalyzer;
+  semanticAnalyzer.set_arena(&parser.getArena()); // For implicit cast nodes
   semanticAnalyzer.set_warnings_enabled(options.warningsEnabled);
   semanticAnalyzer.analyze_program(ast);
+  timing.mark("semantic");
 
   if (semanticAnalyzer.has_errors()) {
     reportError("Semantic analysis failed");
@@ -339,6 +1070,7 @@ bool CompilerDriver::compile(const std::string &sourceCode,
   // ========================================================================
   reportInfo("Stage 4: IR Generation (SSA Form)");
 
+  timing.start();
   IRCodeGenerator irCodeGen;
 
   // USER STORY #13: Pass type information to IR Generator
@@ -348,7 +1080,13 @@ bool CompilerDriver::compile(const std::string &sourceCode,
   std::vector<std::unique_ptr<IRFunction>> irFunctions;
 
   for (const auto &decl : ast) {
-    if (auto *funcDecl = dynamic_cast<FunctionDecl *>(decl.get())) {
+    if (auto *funcDecl = dynamic_cast<FunctionDecl *>(decl)) {
+      // Forward declarations carry no body; emitting them would produce an
+      // empty global symbol that collides with the real definition at link
+      // time (fatal for multi-file builds).
+      if (funcDecl->getBody() == nullptr) {
+        continue;
+      }
       try {
         auto irFunc = irCodeGen.generateFunctionIR(funcDecl);
         if (irFunc) {
@@ -362,6 +1100,7 @@ bool CompilerDriver::compile(const std::string &sourceCode,
     }
   }
 
+  timing.mark("ir_gen");
   reportInfo("  -> Generated IR for " + std::to_string(irFunctions.size()) +
              " function(s)");
 
@@ -370,23 +1109,100 @@ bool CompilerDriver::compile(const std::string &sourceCode,
   // ========================================================================
   if (options.optimize) {
     reportInfo("Stage 5: IR Optimization");
+    timing.start();
     IROptimizer optimizer;
-    for (auto &irFunc : irFunctions) {
-      optimizer.optimize(irFunc.get());
-    }
+    // Per-function optimization runs on a worker pool inside this overload
+    optimizer.optimize(irFunctions);
+    timing.mark("optimize");
+    timing.setOptimizerStats(optimizer.getPassManager().statisticsToJson());
     reportInfo("  -> Optimization complete");
+
+    // Dump per-pass timing/instruction statistics if requested
+    if (!options.dumpOptStatsPath.empty()) {
+      reportInfo("  -> Dumping pass statistics to: " + options.dumpOptStatsPath);
+      std::ofstream outFile(options.dumpOptStatsPath);
+      if (!outFile) {
+        reportError("Failed to open file for writing: " +
+                    options.dumpOptStatsPath);
+      } else {
+        outFile << optimizer.getPassManager().statisticsToJson();
+      }
+    }
   } else {
     reportInfo("Stage 5: IR Optimization - SKIPPED (optimization disabled)");
   }
 
+  // ========================================================================
+  // Stage 6 (fast path): Direct ELF object emission
+  // ========================================================================
+  // With --direct-obj, machine code is encoded straight from the IR and
+  // written as a relocatable object, skipping both the AT&T text
+  // formatting and the external `as` process. The textual pipeline below
+  // remains in charge whenever assembly output is requested (-S or
+  // --dump-asm) or the emitter hits a construct it does not support.
+  if (options.directObject && !options.emitAssembly &&
+      options.dumpAsmPath.empty()) {
+    reportInfo("Stage 6: Direct object emission (ELF)");
+
+    std::string objFile = getTempFileName(sourceName, ".o");
+    if (options.emitObject) {
+      objFile = options.outputFile;
+    }
+
+    std::vector<IRFunction *> borrowed;
+    borrowed.reserve(irFunctions.size());
+    for (const auto &irFunc : irFunctions) {
+      borrowed.push_back(irFunc.get());
+    }
+
+    DirectObjectEmitter emitter;
+    if (emitter.emit(borrowed, objFile)) {
+      reportInfo("  -> Object file written: " + objFile);
+
+      if (options.emitObject) {
+        reportInfo("========================================");
+        reportInfo("Compilation successful (object only)");
+        reportInfo("========================================");
+        return true;
+      }
+
+      if (!linkFiles({objFile}, options.outputFile)) {
+        return false;
+      }
+#ifndef _WIN32
+      chmod(options.outputFile.c_str(), 0755);
+#endif
+      if (!options.dumpHexPath.empty()) {
+        std::string hexOutput = generateHexDump(options.outputFile);
+        std::ofstream outFile(options.dumpHexPath);
+        if (outFile) {
+          outFile << hexOutput;
+        }
+      }
+      cleanup({objFile});
+      reportInfo("========================================");
+      reportInfo("Compilation successful!");
+      reportInfo("Executable: " + options.outputFile);
+      reportInfo("========================================");
+      return true;
+    }
+
+    reportInfo("  -> Direct emission unavailable (" +
+               emitter.getUnsupportedReason() +
+               "); falling back to the assembler path");
+  }
+
   // ========================================================================
   // Stage 6: Code Generation (x86-64)
   // ========================================================================
   reportInfo("Stage 6: Code Generation (x86-64)");
 
+  timing.start();
   CodeGenerator codeGen;
   codeGen.setSourceFile(sourceName);
+  codeGen.setRegisterAllocationMode(options.regalloc);
   std::string assembly = codeGen.generateProgram(irFunctions);
+  timing.mark("codegen");
 
   reportInfo("  -> Generated " + std::to_string(assembly.size()) +
              " bytes of assembly");
@@ -406,6 +1222,31 @@ bool CompilerDriver::compile(const std::string &sourceCode,
     }
   }
 
+  // ========================================================================
+  // Stage 7 (alternative): In-memory assemble and link (--no-temp-files)
+  // ========================================================================
+  // Streams the assembly to `as` over a pipe and links the object straight
+  // out of a memfd — no .s or .o on disk, nothing for cleanup() to do.
+  if (options.noTempFiles && !options.emitAssembly) {
+    reportInfo("Stage 7: In-memory assemble and link (no temp files)");
+    timing.start();
+    if (!assembleAndLinkInMemory(assembly, sourceName)) {
+      return false;
+    }
+    timing.mark("assemble_link");
+    if (!options.emitObject && !options.dumpHexPath.empty()) {
+      std::string hexOutput = generateHexDump(options.outputFile);
+      std::ofstream outFile(options.dumpHexPath);
+      if (outFile) {
+        outFile << hexOutput;
+      }
+    }
+    reportInfo("========================================");
+    reportInfo("Compilation successful!");
+    reportInfo("========================================");
+    return true;
+  }
+
   // ========================================================================
   // Stage 7: Write Assembly File
   // ========================================================================
@@ -451,9 +1292,11 @@ bool CompilerDriver::compile(const std::string &sourceCode,
     objFile = options.outputFile; // User wants .o file as output
   }
 
+  timing.start();
   if (!assembleFile(asmFile, objFile)) {
     return false;
   }
+  timing.mark("assemble");
 
   if (options.emitObject) {
     reportInfo("Object file written: " + objFile);
@@ -469,9 +1312,11 @@ bool CompilerDriver::compile(const std::string &sourceCode,
   // ========================================================================
   reportInfo("Stage 8: Linking");
 
+  timing.start();
   if (!linkFiles({objFile}, options.outputFile)) {
     return false;
   }
+  timing.mark("link");
 
   // Make executable
 #ifndef _WIN32
@@ -513,11 +1358,329 @@ bool CompilerDriver::compile(const std::string &sourceCode,
   return true;
 }
 
+// Worker-thread pipeline for a single file, ending at the object file.
+// Mirrors the stages of compile() but writes every diagnostic into
+// `diagnostics` (via ErrorHandler::set_output_stream) so concurrent files
+// never interleave on stderr; compileMultiple replays the buffers in
+// input order afterwards.
+bool CompilerDriver::compileToObject(const std::string &sourcePath,
+                                     const std::string &asmFile,
+                                     const std::string &objFile,
+                                     std::string &diagnostics) {
+  std::ostringstream log;
+  bool ok = false;
+
+  try {
+    do {
+      SourceBuffer buffer;
+      if (!buffer.loadFile(sourcePath)) {
+        log << "Error: " << buffer.getError() << "\n";
+        break;
+      }
+
+      // Stage 1+2: Lexing and parsing
+      Lexer lexer(buffer.view(), sourcePath);
+      lexer.getErrorHandler().set_output_stream(&log);
+
+      Parser parser(lexer);
+      parser.getErrorHandler().set_output_stream(&log);
+      auto ast = parser.parseProgram();
+      if (parser.hasErrors() || lexer.hasErrors()) {
+        log << "Error: Parsing failed: " << sourcePath << "\n";
+        break;
+      }
+
+      // Stage 3: Semantic analysis
+      SemanticAnalyzer semanticAnalyzer;
+      semanticAnalyzer.getErrorHandler().set_output_stream(&log);
+      semanticAnalyzer.set_arena(&parser.getArena());
+      semanticAnalyzer.set_warnings_enabled(options.warningsEnabled);
+      semanticAnalyzer.analyze_program(ast);
+      if (semanticAnalyzer.has_errors()) {
+        log << "Error: Semantic analysis failed: " << sourcePath << "\n";
+        break;
+      }
+
+      // Stage 4: IR generation
+      IRCodeGenerator irCodeGen;
+      irCodeGen.setTypeMaps(semanticAnalyzer.get_expression_types(),
+                            semanticAnalyzer.get_struct_types());
+      std::vector<std::unique_ptr<IRFunction>> irFunctions;
+      bool irFailed = false;
+      for (const auto &decl : ast) {
+        if (auto *funcDecl = dynamic_cast<FunctionDecl *>(decl)) {
+          if (funcDecl->getBody() == nullptr) {
+            continue; // Forward declaration: the definition lives elsewhere
+          }
+          try {
+            auto irFunc = irCodeGen.generateFunctionIR(funcDecl);
+            if (irFunc) {
+              irFunctions.push_back(std::move(irFunc));
+            }
+          } catch (const std::exception &e) {
+            log << "Error: IR generation failed for function '"
+                << funcDecl->getName() << "': " << e.what() << "\n";
+            irFailed = true;
+            break;
+          }
+        }
+      }
+      if (irFailed) {
+        break;
+      }
+
+      // Stage 5: Optimization
+      if (options.optimize) {
+        IROptimizer optimizer;
+        for (auto &irFunc : irFunctions) {
+          optimizer.optimize(irFunc.get());
+        }
+      }
+
+      // Stage 6: Code generation
+      CodeGenerator codeGen;
+      codeGen.setSourceFile(sourcePath);
+      codeGen.setRegisterAllocationMode(options.regalloc);
+      std::string assembly = codeGen.generateProgram(irFunctions);
+
+      std::ofstream asmOut(asmFile);
+      if (!asmOut) {
+        log << "Error: Failed to open file for writing: " << asmFile << "\n";
+        break;
+      }
+      asmOut << assembly;
+      asmOut.close();
+
+      if (options.emitAssembly) {
+        ok = true;
+        break;
+      }
+
+      // Stage 7: Assemble. Run `as` directly here instead of through
+      // assembleFile(), which reports to the shared stderr/errorCount.
+      std::string command = "as -o " + objFile + " " + asmFile + " 2>&1";
+      FILE *pipe = popen(command.c_str(), "r");
+      if (!pipe) {
+        log << "Error: Failed to execute command: " << command << "\n";
+        break;
+      }
+      char cmdBuffer[256];
+      std::string output;
+      while (fgets(cmdBuffer, sizeof(cmdBuffer), pipe) != nullptr) {
+        output += cmdBuffer;
+      }
+      if (pclose(pipe) != 0) {
+        log << "Error: Assembly failed: " << sourcePath << "\n" << output;
+        break;
+      }
+
+        ok = true;
+    } while (false);
+  } catch (const std::exception &e) {
+    // Never let an exception escape a worker thread (it would terminate
+    // the whole process); record it as this file's failure instead.
+    log << "Error: Internal error while compiling " << sourcePath << ": "
+        << e.what() << "\n";
+    ok = false;
+  }
+
+  diagnostics = log.str();
+  return ok;
+}
+
 bool CompilerDriver::compileMultiple(
     const std::vector<std::string> &sourceFiles) {
-  // TODO: Implement multi-file compilation
-  reportError("Multi-file compilation not yet implemented");
-  return false;
+  errorCount = 0;
+
+  if (sourceFiles.empty()) {
+    reportError("No source files to compile");
+    return false;
+  }
+
+  // Derive per-file output names: "dir/foo.c" -> "foo" (+ extension)
+  auto baseName = [](const std::string &path) {
+    size_t slash = path.find_last_of("/\\");
+    std::string name = (slash == std::string::npos) ? path : path.substr(slash + 1);
+    size_t dot = name.find_last_of('.');
+    return (dot == std::string::npos) ? name : name.substr(0, dot);
+  };
+
+  struct FileResult {
+    bool success = false;
+    std::string asmFile;
+    std::string objFile;
+    std::string diagnostics;
+  };
+
+  const size_t fileCount = sourceFiles.size();
+  std::vector<FileResult> results(fileCount);
+  for (size_t i = 0; i < fileCount; ++i) {
+    std::string base = baseName(sourceFiles[i]);
+    if (options.emitAssembly) {
+      results[i].asmFile = base + ".s"; // Per-file .s next to the cwd
+    } else {
+      // Index keeps temp names unique even for same-named files in
+      // different directories.
+      results[i].asmFile =
+          getTempFileName("mycc_" + std::to_string(i) + "_" + base, ".s");
+    }
+    if (options.emitObject) {
+      results[i].objFile = base + ".o"; // Per-file .o, gcc -c style
+    } else {
+      results[i].objFile =
+          getTempFileName("mycc_" + std::to_string(i) + "_" + base, ".o");
+    }
+  }
+
+  // Worker pool: each thread claims the next unprocessed file. Every
+  // per-file pipeline is independent until the final link, so this scales
+  // with core count.
+  unsigned workerCount =
+      options.jobs > 0 ? static_cast<unsigned>(options.jobs)
+                       : std::thread::hardware_concurrency();
+  if (workerCount == 0) {
+    workerCount = 1;
+  }
+  if (workerCount > fileCount) {
+    workerCount = static_cast<unsigned>(fileCount);
+  }
+
+  reportInfo("Compiling " + std::to_string(fileCount) + " file(s) with " +
+             std::to_string(workerCount) + " worker(s)");
+
+  std::atomic<size_t> nextFile{0};
+  auto runWorker = [&]() {
+    for (size_t i = nextFile.fetch_add(1); i < fileCount;
+         i = nextFile.fetch_add(1)) {
+      results[i].success = compileToObject(sourceFiles[i], results[i].asmFile,
+                                           results[i].objFile,
+                                           results[i].diagnostics);
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(workerCount);
+  for (unsigned t = 0; t < workerCount; ++t) {
+    workers.emplace_back(runWorker);
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  // Deterministic merge: replay each file's buffered diagnostics in input
+  // order, regardless of which thread compiled it when.
+  bool allSucceeded = true;
+  std::vector<std::string> objFiles;
+  std::vector<std::string> tempFiles;
+  for (size_t i = 0; i < fileCount; ++i) {
+    if (!results[i].diagnostics.empty()) {
+      std::cerr << results[i].diagnostics;
+    }
+    if (!results[i].success) {
+      reportError("Compilation failed: " + sourceFiles[i]);
+      allSucceeded = false;
+      continue;
+    }
+    objFiles.push_back(results[i].objFile);
+    if (!options.emitAssembly) {
+      tempFiles.push_back(results[i].asmFile);
+    }
+    if (!options.emitObject && !options.emitAssembly) {
+      tempFiles.push_back(results[i].objFile);
+    }
+  }
+
+  if (!allSucceeded) {
+    cleanup(tempFiles);
+    return false;
+  }
+
+  // Per-file outputs requested: nothing to link.
+  if (options.emitAssembly || options.emitObject) {
+    cleanup(tempFiles);
+    return true;
+  }
+
+  // Final link is the only serialized step.
+  reportInfo("Linking " + std::to_string(objFiles.size()) + " object file(s)");
+  if (!linkFiles(objFiles, options.outputFile)) {
+    cleanup(tempFiles);
+    return false;
+  }
+
+#ifndef _WIN32
+  chmod(options.outputFile.c_str(), 0755);
+#endif
+
+  cleanup(tempFiles);
+
+  reportInfo("========================================");
+  reportInfo("Compilation successful!");
+  reportInfo("Executable: " + options.outputFile);
+  reportInfo("========================================");
+  return true;
+}
+
+// Resolve (and lazily build) the cached startup object. Content-hash
+// keyed: a changed generateStartupCode() produces a new cache entry, and
+// stale ones are simply never referenced again.
+std::string CompilerDriver::getStartupObject() {
+#ifdef _WIN32
+  return std::string(); // Standalone ELF startup is POSIX-only
+#else
+  std::string startupAsm = generateStartupCode();
+
+  // FNV-1a content hash keys the cache entry
+  uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : startupAsm) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+
+  // XDG cache directory, with ~/.cache fallback, then the temp dir
+  std::string cacheRoot;
+  const char *xdg = getenv("XDG_CACHE_HOME");
+  const char *home = getenv("HOME");
+  if (xdg != nullptr && *xdg != '\0') {
+    cacheRoot = std::string(xdg) + "/mycc";
+  } else if (home != nullptr && *home != '\0') {
+    cacheRoot = std::string(home) + "/.cache/mycc";
+  } else {
+    cacheRoot = tempDir + "/mycc-cache";
+  }
+
+  std::ostringstream name;
+  name << cacheRoot << "/crt_" << std::hex << hash << ".o";
+  std::string objPath = name.str();
+
+  struct stat st;
+  if (stat(objPath.c_str(), &st) == 0 && st.st_size > 0) {
+    return objPath; // Warm cache: no assembler run at all
+  }
+
+  // Cold cache: create the directory chain and assemble once. Assemble to
+  // a temporary name and rename so concurrent compiles never observe a
+  // half-written object.
+  std::string parent = cacheRoot.substr(0, cacheRoot.find_last_of('/'));
+  mkdir(parent.c_str(), 0755);
+  mkdir(cacheRoot.c_str(), 0755);
+
+  std::string tmpPath = objPath + "." + std::to_string(getpid()) + ".tmp";
+  std::string output;
+  if (!runPipedCommand({"as", "-o", tmpPath, "-"}, &startupAsm, output)) {
+    reportError("Failed to assemble startup code");
+    if (!output.empty()) {
+      std::cerr << output << std::endl;
+    }
+    return std::string();
+  }
+  if (rename(tmpPath.c_str(), objPath.c_str()) != 0) {
+    remove(tmpPath.c_str());
+    return std::string();
+  }
+  reportInfo("Assembled and cached startup object: " + objPath);
+  return objPath;
+#endif
 }
 
 std::string CompilerDriver::generateStartupCode() {
@@ -0,0 +1,92 @@
+#include "source_buffer.h"
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+SourceBuffer::~SourceBuffer()
+{
+    release();
+}
+
+void SourceBuffer::release()
+{
+#ifndef _WIN32
+    if (mapped_data_ != nullptr)
+    {
+        munmap(mapped_data_, mapped_size_);
+    }
+#endif
+    mapped_data_ = nullptr;
+    mapped_size_ = 0;
+    fallback_.clear();
+    view_ = std::string_view();
+    loaded_ = false;
+    error_.clear();
+}
+
+bool SourceBuffer::loadFile(const std::string &path)
+{
+    release();
+
+#ifndef _WIN32
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        error_ = "Cannot open source file: " + path;
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        error_ = "Cannot stat source file: " + path;
+        close(fd);
+        return false;
+    }
+
+    // mmap only regular, non-empty files. Empty files and special files
+    // (pipes, devices) go through the fallback read below.
+    if (S_ISREG(st.st_mode) && st.st_size > 0)
+    {
+        void *addr = mmap(nullptr, static_cast<size_t>(st.st_size),
+                          PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd); // Mapping stays valid after close
+        if (addr != MAP_FAILED)
+        {
+            mapped_data_ = addr;
+            mapped_size_ = static_cast<size_t>(st.st_size);
+            view_ = std::string_view(static_cast<const char *>(addr), mapped_size_);
+            loaded_ = true;
+            return true;
+        }
+        // mmap failed (e.g. no memory, odd filesystem): fall through to
+        // the buffered read rather than failing the compile.
+    }
+    else
+    {
+        close(fd);
+    }
+#endif
+
+    // Fallback: ordinary buffered read into owned storage.
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        error_ = "Cannot open source file: " + path;
+        return false;
+    }
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    fallback_ = contents.str();
+    view_ = std::string_view(fallback_);
+    loaded_ = true;
+    return true;
+}
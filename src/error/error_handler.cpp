@@ -20,7 +20,8 @@ ErrorHandler::ErrorHandler(bool enable_colors)
       note_count_(0),
       colors_enabled_(enable_colors),
       max_errors_(10),  // Stop after 10 errors (user story requirement)
-      show_source_context_(true)  // Enable by default
+      show_source_context_(true),  // Enable by default
+      output_stream_(nullptr)  // Default sink is std::cerr
 {
 }
 
@@ -42,16 +43,17 @@ void ErrorHandler::error(const std::string& message, const SourceLocation& locat
 
     // If we just reached the limit, emit a note
     if (max_errors_ > 0 && error_count_ == max_errors_) {
-        std::cerr << "\n";
+        std::ostream& os = out();
+        os << "\n";
         if (colors_enabled_) {
-            std::cerr << COLOR_BOLD;
+            os << COLOR_BOLD;
         }
-        std::cerr << "Maximum error limit reached (" << max_errors_ << " errors). ";
-        std::cerr << "Stopping compilation.";
+        os << "Maximum error limit reached (" << max_errors_ << " errors). ";
+        os << "Stopping compilation.";
         if (colors_enabled_) {
-            std::cerr << COLOR_RESET;
+            os << COLOR_RESET;
         }
-        std::cerr << "\n";
+        os << "\n";
     }
 }
 
@@ -156,7 +158,7 @@ void ErrorHandler::print_summary(std::ostream& os) const {
 // ============================================================================
 
 void ErrorHandler::emit_diagnostic(const Diagnostic& diag) {
-    std::ostream& os = std::cerr;
+    std::ostream& os = out();
 
     // Print location if available
     if (diag.location.isValid()) {
@@ -214,8 +216,9 @@ std::string ErrorHandler::get_level_name(DiagnosticLevel level) const {
 // Source Code Context Support
 // ============================================================================
 
-void ErrorHandler::register_source(const std::string& filename, const std::string& source_code) {
-    source_files_[filename] = source_code;
+void ErrorHandler::register_source(const std::string& filename, std::string_view source_code) {
+    source_files_[filename].text = source_code;
+    source_files_[filename].line_offsets.clear();
 }
 
 std::string ErrorHandler::get_source_line(const std::string& filename, int line_number) const {
@@ -225,30 +228,29 @@ std::string ErrorHandler::get_source_line(const std::string& filename, int line_
         return "";  // Source not available
     }
 
-    const std::string& source = it->second;
-
-    // Split source into lines and extract the requested line
-    int current_line = 1;
-    std::string::size_type start = 0;
+    const RegisteredSource& source = it->second;
 
-    while (start < source.length()) {
-        // Find end of current line
-        std::string::size_type end = source.find('\n', start);
-        if (end == std::string::npos) {
-            end = source.length();
-        }
-
-        // Check if this is the line we want
-        if (current_line == line_number) {
-            return source.substr(start, end - start);
+    // Build the line-offset index on first use; error-free compiles never
+    // reach this point and pay nothing for it.
+    if (source.line_offsets.empty() && !source.text.empty()) {
+        source.line_offsets.push_back(0);
+        for (size_t pos = 0; pos < source.text.size(); ++pos) {
+            if (source.text[pos] == '\n') {
+                source.line_offsets.push_back(pos + 1);
+            }
         }
+    }
 
-        // Move to next line
-        current_line++;
-        start = end + 1;
+    if (line_number < 1 ||
+        static_cast<size_t>(line_number) > source.line_offsets.size()) {
+        return "";  // Line number out of range
     }
 
-    return "";  // Line number out of range
+    size_t start = source.line_offsets[line_number - 1];
+    size_t end = (static_cast<size_t>(line_number) < source.line_offsets.size())
+                     ? source.line_offsets[line_number] - 1  // Drop the newline
+                     : source.text.size();
+    return std::string(source.text.substr(start, end - start));
 }
 
 void ErrorHandler::show_source_context(const SourceLocation& location) const {
@@ -256,7 +258,7 @@ void ErrorHandler::show_source_context(const SourceLocation& location) const {
         return;
     }
 
-    std::ostream& os = std::cerr;
+    std::ostream& os = out();
 
     // Get the source line
     std::string line = get_source_line(location.filename, location.line);
@@ -1,6 +1,33 @@
 #include "ir.h"
 #include <sstream>
 
+// ============================================================================
+// IRStringTable Implementation
+// ============================================================================
+IRStringTable &IRStringTable::instance() {
+    static IRStringTable table;
+    return table;
+}
+
+ValueId IRStringTable::intern(const std::string &text) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(std::string_view(text));
+    if (it != index_.end()) {
+        return it->second;
+    }
+    ValueId id = static_cast<ValueId>(texts_.size());
+    texts_.push_back(text);
+    index_.emplace(std::string_view(texts_.back()), id);
+    return id;
+}
+
+const std::string &IRStringTable::text(ValueId id) const {
+    // The deque is append-only and element references are stable, but the
+    // container itself must not be read while another thread grows it.
+    std::lock_guard<std::mutex> lock(mutex_);
+    return texts_[id];
+}
+
 // ============================================================================
 // IROperand Implementation
 // ============================================================================
@@ -217,6 +244,201 @@ std::string IRBasicBlock::toString() const {
     return oss.str();
 }
 
+// ============================================================================
+// IRFunction CFG Construction
+// ============================================================================
+
+// Split the linear instruction stream into real basic blocks and wire
+// successor/predecessor edges by resolving jump targets through a
+// label->block map. Instruction order is preserved.
+void IRFunction::buildCFG() {
+    // 1. Flatten the current blocks into one ordered instruction stream.
+    std::vector<std::unique_ptr<IRInstruction>> stream;
+    for (auto& block : basicBlocks) {
+        auto& insts = block->getInstructions();
+        for (auto& inst : insts) {
+            stream.push_back(std::move(inst));
+        }
+    }
+
+    std::string entryLabel =
+        basicBlocks.empty() ? (name + "_entry") : basicBlocks.front()->getLabel();
+    basicBlocks.clear();
+    labelToBlock.clear();
+
+    // 2. Re-split: a block starts at every LABEL and after every terminator
+    // (JUMP, JUMP_IF_FALSE, RETURN).
+    auto startBlock = [&](const std::string& label) -> IRBasicBlock* {
+        basicBlocks.push_back(std::make_unique<IRBasicBlock>(label));
+        IRBasicBlock* block = basicBlocks.back().get();
+        labelToBlock[label] = block;
+        return block;
+    };
+
+    IRBasicBlock* current = startBlock(entryLabel);
+    bool afterTerminator = false;
+    int syntheticBlocks = 0;
+
+    for (auto& inst : stream) {
+        IROpcode opcode = inst->getOpcode();
+
+        if (opcode == IROpcode::LABEL) {
+            const auto* labelInst = static_cast<const LabelInst*>(inst.get());
+            // A label always begins a block (unless the current one is
+            // still empty, in which case it just names it too).
+            if (!current->getInstructions().empty() || afterTerminator) {
+                current = startBlock(labelInst->getLabelName());
+            } else {
+                labelToBlock[labelInst->getLabelName()] = current;
+            }
+            afterTerminator = false;
+        } else if (afterTerminator) {
+            // First instruction after a terminator with no label: an
+            // anonymous fallthrough block (unreachable unless jumped to).
+            current = startBlock(name + "_bb" + std::to_string(syntheticBlocks++));
+            afterTerminator = false;
+        }
+
+        bool isTerminator = (opcode == IROpcode::JUMP ||
+                             opcode == IROpcode::JUMP_IF_FALSE ||
+                             opcode == IROpcode::RETURN);
+        current->addInstruction(std::move(inst));
+        if (isTerminator) {
+            afterTerminator = true;
+        }
+    }
+
+    // 3. Wire edges from each block's last instruction.
+    for (size_t i = 0; i < basicBlocks.size(); ++i) {
+        IRBasicBlock* block = basicBlocks[i].get();
+        IRBasicBlock* next =
+            (i + 1 < basicBlocks.size()) ? basicBlocks[i + 1].get() : nullptr;
+
+        auto link = [](IRBasicBlock* from, IRBasicBlock* to) {
+            from->addSuccessor(to);
+            to->addPredecessor(from);
+        };
+
+        const auto& insts = block->getInstructions();
+        IROpcode last = insts.empty() ? IROpcode::LABEL
+                                      : insts.back()->getOpcode();
+
+        if (last == IROpcode::JUMP) {
+            const auto* jump = static_cast<const JumpInst*>(insts.back().get());
+            auto it = labelToBlock.find(jump->getTargetLabel());
+            if (it != labelToBlock.end()) {
+                link(block, it->second);
+            }
+        } else if (last == IROpcode::JUMP_IF_FALSE) {
+            const auto* jump =
+                static_cast<const JumpIfFalseInst*>(insts.back().get());
+            auto it = labelToBlock.find(jump->getTargetLabel());
+            if (it != labelToBlock.end()) {
+                link(block, it->second);
+            }
+            if (next != nullptr) {
+                link(block, next); // Condition true: fall through
+            }
+        } else if (last == IROpcode::RETURN) {
+            // No successors
+        } else if (next != nullptr) {
+            link(block, next); // Plain fallthrough
+        }
+    }
+}
+
+// ============================================================================
+// Dominator Tree (Cooper-Harvey-Kennedy iterative algorithm)
+// ============================================================================
+
+void IRFunction::computeDominators() {
+    IRBasicBlock* entry = getEntryBlock();
+    if (entry == nullptr) {
+        return;
+    }
+
+    // Reverse postorder over successor edges (iterative DFS).
+    std::vector<IRBasicBlock*> postorder;
+    std::unordered_map<IRBasicBlock*, bool> visited;
+    std::vector<std::pair<IRBasicBlock*, size_t>> stack;
+    stack.push_back({entry, 0});
+    visited[entry] = true;
+    while (!stack.empty()) {
+        auto& [block, childIndex] = stack.back();
+        if (childIndex < block->getSuccessors().size()) {
+            IRBasicBlock* succ = block->getSuccessors()[childIndex++];
+            if (!visited[succ]) {
+                visited[succ] = true;
+                stack.push_back({succ, 0});
+            }
+        } else {
+            postorder.push_back(block);
+            stack.pop_back();
+        }
+    }
+
+    std::vector<IRBasicBlock*> rpo(postorder.rbegin(), postorder.rend());
+    for (size_t i = 0; i < rpo.size(); ++i) {
+        rpo[i]->setRPOIndex(static_cast<int>(i));
+        rpo[i]->setImmediateDominator(nullptr);
+    }
+    entry->setImmediateDominator(entry);
+
+    // Two finger intersection walking up the current idom tree.
+    auto intersect = [](IRBasicBlock* a, IRBasicBlock* b) {
+        while (a != b) {
+            while (a->getRPOIndex() > b->getRPOIndex()) {
+                a = a->getImmediateDominator();
+            }
+            while (b->getRPOIndex() > a->getRPOIndex()) {
+                b = b->getImmediateDominator();
+            }
+        }
+        return a;
+    };
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (size_t i = 1; i < rpo.size(); ++i) {
+            IRBasicBlock* block = rpo[i];
+            IRBasicBlock* newIdom = nullptr;
+            for (IRBasicBlock* pred : block->getPredecessors()) {
+                if (pred->getImmediateDominator() == nullptr) {
+                    continue; // Unprocessed or unreachable predecessor
+                }
+                newIdom = (newIdom == nullptr) ? pred : intersect(pred, newIdom);
+            }
+            if (newIdom != nullptr &&
+                block->getImmediateDominator() != newIdom) {
+                block->setImmediateDominator(newIdom);
+                changed = true;
+            }
+        }
+    }
+}
+
+bool IRFunction::dominates(const IRBasicBlock* a, const IRBasicBlock* b) {
+    // Walk b's idom chain up to the entry (whose idom is itself).
+    const IRBasicBlock* runner = b;
+    while (runner != nullptr) {
+        if (runner == a) {
+            return true;
+        }
+        const IRBasicBlock* idom = runner->getImmediateDominator();
+        if (idom == runner) {
+            break; // Reached the entry
+        }
+        runner = idom;
+    }
+    return false;
+}
+
+IRBasicBlock* IRFunction::getBlockForLabel(const std::string& label) const {
+    auto it = labelToBlock.find(label);
+    return (it != labelToBlock.end()) ? it->second : nullptr;
+}
+
 // ============================================================================
 // IRFunction Implementation
 // ============================================================================
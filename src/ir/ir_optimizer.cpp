@@ -1,14 +1,129 @@
 #include "ir_optimizer.h"
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <thread>
 #include <sstream>
 #include <stdexcept>
+#include <unordered_set>
+
+// ============================================================================
+// PassManager Implementation
+// ============================================================================
+
+void PassManager::registerPass(const std::string& name, PassFn pass)
+{
+    RegisteredPass registered;
+    registered.fn = std::move(pass);
+    registered.stats.name = name;
+    passes_.push_back(std::move(registered));
+}
+
+long long PassManager::countInstructions(const IRFunction* function)
+{
+    long long count = 0;
+    for (const auto& block : function->getBasicBlocks()) {
+        count += static_cast<long long>(block->getInstructions().size());
+    }
+    return count;
+}
+
+void PassManager::run(IRFunction* function)
+{
+    for (auto& pass : passes_) {
+        long long before = countInstructions(function);
+        auto start = std::chrono::steady_clock::now();
+
+        int transformations = pass.fn(function);
+
+        auto end = std::chrono::steady_clock::now();
+        pass.stats.runs++;
+        pass.stats.transformations += transformations;
+        pass.stats.microseconds +=
+            std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+                .count();
+        pass.stats.instructionsBefore += before;
+        pass.stats.instructionsAfter += countInstructions(function);
+    }
+}
+
+std::vector<PassStatistics> PassManager::getStatistics() const
+{
+    std::vector<PassStatistics> snapshot;
+    snapshot.reserve(passes_.size());
+    for (const auto& pass : passes_) {
+        snapshot.push_back(pass.stats);
+    }
+    return snapshot;
+}
+
+void PassManager::mergeStatistics(const PassManager& other)
+{
+    for (size_t i = 0; i < passes_.size() && i < other.passes_.size(); ++i) {
+        PassStatistics& into = passes_[i].stats;
+        const PassStatistics& from = other.passes_[i].stats;
+        into.runs += from.runs;
+        into.transformations += from.transformations;
+        into.microseconds += from.microseconds;
+        into.instructionsBefore += from.instructionsBefore;
+        into.instructionsAfter += from.instructionsAfter;
+    }
+}
+
+void PassManager::resetStatistics()
+{
+    for (auto& pass : passes_) {
+        std::string name = pass.stats.name;
+        pass.stats = PassStatistics();
+        pass.stats.name = name;
+    }
+}
+
+std::string PassManager::statisticsToJson() const
+{
+    // Pass names are compiler-chosen identifiers, so no escaping is needed.
+    std::ostringstream json;
+    json << "[\n";
+    for (size_t i = 0; i < passes_.size(); ++i) {
+        const PassStatistics& stats = passes_[i].stats;
+        json << "  {\n";
+        json << "    \"pass\": \"" << stats.name << "\",\n";
+        json << "    \"runs\": " << stats.runs << ",\n";
+        json << "    \"transformations\": " << stats.transformations << ",\n";
+        json << "    \"wall_time_us\": " << stats.microseconds << ",\n";
+        json << "    \"instructions_before\": " << stats.instructionsBefore
+             << ",\n";
+        json << "    \"instructions_after\": " << stats.instructionsAfter
+             << "\n";
+        json << "  }" << (i + 1 < passes_.size() ? "," : "") << "\n";
+    }
+    json << "]\n";
+    return json.str();
+}
 
 // ============================================================================
 // Constructor
 // ============================================================================
 IROptimizer::IROptimizer()
-    : constantFoldingCount(0), deadCodeEliminationCount(0), cseCount(0)
+    : constantFoldingCount(0), deadCodeEliminationCount(0), cseCount(0),
+      inliningCount(0)
 {
+    // Register the standard pipeline; optimize() runs it in this order.
+    passManager_.registerPass("constant-folding", [this](IRFunction* function) {
+        return constantFoldingPass(function);
+    });
+    passManager_.registerPass("licm", [this](IRFunction* function) {
+        return loopInvariantCodeMotionPass(function);
+    });
+    passManager_.registerPass("strength-reduction", [this](IRFunction* function) {
+        return strengthReductionPass(function);
+    });
+    passManager_.registerPass("cse", [this](IRFunction* function) {
+        return commonSubexpressionEliminationPass(function);
+    });
+    passManager_.registerPass("dce", [this](IRFunction* function) {
+        return deadCodeEliminationPass(function);
+    });
 }
 
 // ============================================================================
@@ -183,68 +298,46 @@ int IROptimizer::deadCodeEliminationPass(IRFunction* function)
 {
     int totalRemovals = 0;
 
-    // Iterate through all basic blocks in the function
-    auto& blocks = const_cast<std::vector<std::unique_ptr<IRBasicBlock>>&>(
-        function->getBasicBlocks());
-
-    for (auto& block : blocks) {
-        auto& instructions = const_cast<std::vector<std::unique_ptr<IRInstruction>>&>(
-            block->getInstructions());
-
-        // Find the position of the first unconditional jump or return
-        size_t terminatorPos = instructions.size();
-        bool foundTerminator = false;
-
-        for (size_t i = 0; i < instructions.size(); ++i) {
-            IROpcode opcode = instructions[i]->getOpcode();
-
-            // Check for unconditional jump or return
-            if (opcode == IROpcode::JUMP || opcode == IROpcode::RETURN) {
-                terminatorPos = i;
-                foundTerminator = true;
-                break;
+    // With a real CFG, dead code is whole blocks with no path from the
+    // entry: code after an unconditional jump or return lands in its own
+    // (synthetic or labeled) block, and if nothing jumps to it the block is
+    // unreachable. This subsumes the old "instructions after a terminator"
+    // scan and additionally removes dead labeled regions.
+    function->buildCFG();
+
+    std::unordered_set<const IRBasicBlock*> reachable;
+    std::vector<const IRBasicBlock*> worklist;
+    if (function->getEntryBlock() != nullptr) {
+        reachable.insert(function->getEntryBlock());
+        worklist.push_back(function->getEntryBlock());
+    }
+    while (!worklist.empty()) {
+        const IRBasicBlock* block = worklist.back();
+        worklist.pop_back();
+        for (IRBasicBlock* succ : block->getSuccessors()) {
+            if (reachable.insert(succ).second) {
+                worklist.push_back(succ);
             }
         }
+    }
 
-        // If we found a terminator and there are instructions after it
-        if (foundTerminator && terminatorPos + 1 < instructions.size()) {
-            // Count dead instructions (excluding labels, as they may be jump targets)
-            size_t deadCodeStart = terminatorPos + 1;
-            size_t deadCodeCount = 0;
-
-            // Check if the next instruction after terminator is a label
-            // If so, we stop - code after a label is potentially reachable
-            if (deadCodeStart < instructions.size()) {
-                IROpcode nextOpcode = instructions[deadCodeStart]->getOpcode();
-                if (nextOpcode == IROpcode::LABEL) {
-                    // Code after label is reachable, don't remove
-                    continue;
-                }
-            }
-
-            // Count and remove dead instructions until we hit a label or end
-            for (size_t i = deadCodeStart; i < instructions.size(); ++i) {
-                IROpcode opcode = instructions[i]->getOpcode();
-
-                // Stop if we encounter a label (it's a potential jump target)
-                if (opcode == IROpcode::LABEL) {
-                    break;
-                }
-
-                deadCodeCount++;
-            }
-
-            // Remove the dead instructions
-            if (deadCodeCount > 0) {
-                instructions.erase(
-                    instructions.begin() + deadCodeStart,
-                    instructions.begin() + deadCodeStart + deadCodeCount
-                );
-                totalRemovals += deadCodeCount;
-            }
+    auto& blocks = const_cast<std::vector<std::unique_ptr<IRBasicBlock>>&>(
+        function->getBasicBlocks());
+    for (auto it = blocks.begin(); it != blocks.end();) {
+        if (reachable.count(it->get()) == 0) {
+            totalRemovals += static_cast<int>((*it)->getInstructions().size());
+            it = blocks.erase(it);
+        } else {
+            ++it;
         }
     }
 
+    if (totalRemovals > 0) {
+        // Edges and the label map reference removed blocks; rebuild
+        function->buildCFG();
+        function->computeDominators();
+    }
+
     // Update statistics
     deadCodeEliminationCount += totalRemovals;
 
@@ -260,26 +353,6 @@ int IROptimizer::deadCodeEliminationPass(IRFunction* function)
 // Acceptance Criteria:
 // - t0 = a + b; t1 = a + b; → t0 = a + b; t1 = t0;
 
-std::string IROptimizer::getExpressionKey(const IRInstruction* inst) const
-{
-    // Generate a unique string key for an expression
-    // Format: "opcode:operand1:operand2" for binary ops
-    std::string key;
-
-    IROpcode opcode = inst->getOpcode();
-    const auto& operands = inst->getOperands();
-
-    // Add opcode
-    key += std::to_string(static_cast<int>(opcode)) + ":";
-
-    // Add operands
-    for (const auto& operand : operands) {
-        key += operand.toString() + ":";
-    }
-
-    return key;
-}
-
 bool IROptimizer::isCSECandidate(const IRInstruction* inst) const
 {
     // Check if instruction is eligible for CSE
@@ -300,56 +373,172 @@ bool IROptimizer::isCSECandidate(const IRInstruction* inst) const
             opcode == IROpcode::GE);
 }
 
+// ============================================================================
+// Hash-based global value numbering over integer ValueIds.
+//
+// An expression is the tuple (opcode, operand id, operand id) with
+// commutative operations canonicalized by sorting the operand ids, so
+// "a + b" and "b + a" number identically. The available-expression table
+// is scoped along the dominator tree: a dominating block's expressions
+// are visible in every block it dominates, so redundancy across blocks is
+// found too, not just within one block. No strings are built or hashed —
+// keys are three integers.
+//
+// The IR is not in perfect SSA form (loop variables are re-assigned under
+// one version), so any value defined more than once in the function is
+// excluded from numbering entirely; its expressions are not safe to reuse.
+// ============================================================================
+
+namespace {
+
+struct GVNKey
+{
+    uint32_t opcode;
+    uint64_t left;  // (ValueId << 1) | isSSA, so constants and SSA values
+    uint64_t right; // with coincidentally equal ids never collide
+
+    bool operator==(const GVNKey& other) const
+    {
+        return opcode == other.opcode && left == other.left &&
+               right == other.right;
+    }
+};
+
+struct GVNKeyHash
+{
+    size_t operator()(const GVNKey& key) const
+    {
+        uint64_t h = key.opcode;
+        h = h * 0x9E3779B97F4A7C15ULL ^ key.left;
+        h = h * 0x9E3779B97F4A7C15ULL ^ key.right;
+        return static_cast<size_t>(h ^ (h >> 32));
+    }
+};
+
+inline uint64_t gvnOperandId(const IROperand& operand)
+{
+    return (static_cast<uint64_t>(operand.getId()) << 1) |
+           (operand.isSSAValue() ? 1 : 0);
+}
+
+inline bool isCommutative(IROpcode opcode)
+{
+    return opcode == IROpcode::ADD || opcode == IROpcode::MUL ||
+           opcode == IROpcode::EQ || opcode == IROpcode::NE;
+}
+
+} // namespace
+
 int IROptimizer::commonSubexpressionEliminationPass(IRFunction* function)
 {
     int totalOptimizations = 0;
 
-    // Process each basic block independently
-    // (More advanced: could use dominator analysis for inter-block CSE)
-    auto& blocks = const_cast<std::vector<std::unique_ptr<IRBasicBlock>>&>(
-        function->getBasicBlocks());
-
-    for (auto& block : blocks) {
-        auto& instructions = const_cast<std::vector<std::unique_ptr<IRInstruction>>&>(
-            block->getInstructions());
+    function->buildCFG();
+    function->computeDominators();
+    IRBasicBlock* entry = function->getEntryBlock();
+    if (entry == nullptr) {
+        return 0;
+    }
 
-        // Map: expression key -> SSA value that holds the result
-        std::unordered_map<std::string, SSAValue*> availableExpressions;
+    // Values assigned more than once are not in SSA form; expressions
+    // reading or producing them must not be numbered.
+    std::unordered_map<ValueId, int> defCount;
+    for (const auto& block : function->getBasicBlocks()) {
+        for (const auto& inst : block->getInstructions()) {
+            if (inst->getResult() != nullptr) {
+                defCount[inst->getResult()->getId()]++;
+            }
+        }
+    }
+    auto isSingleDef = [&](ValueId id) {
+        auto it = defCount.find(id);
+        return it == defCount.end() || it->second <= 1;
+    };
+
+    // Dominator-tree children (idom of entry is itself, skip that edge)
+    std::unordered_map<const IRBasicBlock*, std::vector<IRBasicBlock*>> domChildren;
+    for (const auto& block : function->getBasicBlocks()) {
+        IRBasicBlock* idom = block->getImmediateDominator();
+        if (idom != nullptr && idom != block.get()) {
+            domChildren[idom].push_back(block.get());
+        }
+    }
 
+    // Scoped available-expression table: each key maps to a stack of
+    // results, pushed on entering a dominator-tree node and popped on the
+    // way back up, so entries are visible exactly in dominated blocks.
+    std::unordered_map<GVNKey, std::vector<SSAValue*>, GVNKeyHash> available;
+
+    // Explicit DFS over the dominator tree (post-action pops this block's
+    // additions)
+    struct Frame
+    {
+        IRBasicBlock* block;
+        size_t nextChild;
+        std::vector<GVNKey> added;
+    };
+    std::vector<Frame> stack;
+    stack.push_back({entry, 0, {}});
+
+    // Process a block's instructions on first visit
+    auto numberBlock = [&](IRBasicBlock* block, std::vector<GVNKey>& added) {
+        auto& instructions = block->getInstructions();
         for (size_t i = 0; i < instructions.size(); ++i) {
             IRInstruction* inst = instructions[i].get();
-
-            // Skip if not a CSE candidate
             if (!isCSECandidate(inst)) {
                 continue;
             }
+            const auto& operands = inst->getOperands();
+            if (operands.size() != 2) {
+                continue;
+            }
+            // Skip anything touching a multiply-defined (non-SSA) value
+            if (!isSingleDef(inst->getResult()->getId()) ||
+                (operands[0].isSSAValue() &&
+                 !isSingleDef(operands[0].getSSAValue().getId())) ||
+                (operands[1].isSSAValue() &&
+                 !isSingleDef(operands[1].getSSAValue().getId()))) {
+                continue;
+            }
 
-            // Generate key for this expression
-            std::string key = getExpressionKey(inst);
-
-            // Check if we've seen this expression before
-            auto it = availableExpressions.find(key);
+            GVNKey key{static_cast<uint32_t>(inst->getOpcode()),
+                       gvnOperandId(operands[0]), gvnOperandId(operands[1])};
+            if (isCommutative(inst->getOpcode()) && key.left > key.right) {
+                std::swap(key.left, key.right);
+            }
 
-            if (it != availableExpressions.end()) {
-                // Found a common subexpression!
-                // Replace this instruction with a MOVE from the previous result
-                SSAValue* previousResult = it->second;
+            auto it = available.find(key);
+            if (it != available.end() && !it->second.empty()) {
+                // Redundant: the dominating computation's result is always
+                // available here. Rewrite to a move.
+                SSAValue* previousResult = it->second.back();
                 SSAValue* currentResult = inst->getResult();
-
-                // Create MOVE instruction: currentResult = previousResult
-                IROperand sourceOperand(*previousResult);
-                instructions[i] = std::make_unique<MoveInst>(currentResult, sourceOperand);
-
+                instructions[i] = std::make_unique<MoveInst>(
+                    currentResult, IROperand(*previousResult));
                 totalOptimizations++;
-
-                // Note: We don't add this MOVE to availableExpressions
-                // because moves are already handled implicitly
             } else {
-                // First time seeing this expression
-                // Record it for future reuse
-                availableExpressions[key] = inst->getResult();
+                available[key].push_back(inst->getResult());
+                added.push_back(key);
             }
         }
+    };
+
+    numberBlock(entry, stack.back().added);
+    while (!stack.empty()) {
+        Frame& frame = stack.back();
+        auto childrenIt = domChildren.find(frame.block);
+        if (childrenIt != domChildren.end() &&
+            frame.nextChild < childrenIt->second.size()) {
+            IRBasicBlock* child = childrenIt->second[frame.nextChild++];
+            stack.push_back({child, 0, {}});
+            numberBlock(child, stack.back().added);
+        } else {
+            // Leaving this dominator-tree node: retract its expressions
+            for (const GVNKey& key : frame.added) {
+                available[key].pop_back();
+            }
+            stack.pop_back();
+        }
     }
 
     // Update statistics
@@ -359,25 +548,772 @@ int IROptimizer::commonSubexpressionEliminationPass(IRFunction* function)
 }
 
 // ============================================================================
-// Optimization Pipeline
+// Loop analysis helpers (LICM / strength reduction)
 // ============================================================================
+// A natural loop per back edge (tail -> header where the header dominates
+// the tail): the header plus every block that can reach the tail without
+// going through the header.
+//
+// Preheaders exploit this codegen's loop shape: the loop header is entered
+// from outside only by falling through from the previous block in layout
+// order, while back edges jump to the header's label. A new unlabeled
+// block placed directly before the header in layout therefore intercepts
+// exactly the entry edge — back-edge jumps skip it — which is precisely
+// where hoisted code belongs.
+
+namespace {
+
+struct NaturalLoop
+{
+    IRBasicBlock* header;
+    std::unordered_set<IRBasicBlock*> blocks; // Includes the header
+};
 
-void IROptimizer::optimize(IRFunction* function)
+std::vector<NaturalLoop> findNaturalLoops(IRFunction* function)
+{
+    std::vector<NaturalLoop> loops;
+    for (const auto& block : function->getBasicBlocks()) {
+        for (IRBasicBlock* succ : block->getSuccessors()) {
+            if (!IRFunction::dominates(succ, block.get())) {
+                continue; // Not a back edge
+            }
+            NaturalLoop loop;
+            loop.header = succ;
+            loop.blocks.insert(succ);
+            std::vector<IRBasicBlock*> worklist;
+            if (loop.blocks.insert(block.get()).second) {
+                worklist.push_back(block.get());
+            }
+            while (!worklist.empty()) {
+                IRBasicBlock* current = worklist.back();
+                worklist.pop_back();
+                for (IRBasicBlock* pred : current->getPredecessors()) {
+                    if (loop.blocks.insert(pred).second) {
+                        worklist.push_back(pred);
+                    }
+                }
+            }
+            loops.push_back(std::move(loop));
+        }
+    }
+    return loops;
+}
+
+// Index of `block` in the function's layout order, or -1
+int layoutIndexOf(IRFunction* function, const IRBasicBlock* block)
+{
+    const auto& blocks = function->getBasicBlocks();
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        if (blocks[i].get() == block) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+// Returns a block suitable for placing loop-entry code, creating an
+// unlabeled block directly before the header when needed. Returns nullptr
+// if the loop's entry shape is not the fallthrough form we can handle
+// (e.g. something outside the loop jumps straight to the header label).
+IRBasicBlock* getOrCreatePreheader(IRFunction* function,
+                                   const NaturalLoop& loop)
 {
-    // Run constant folding pass
-    constantFoldingPass(function);
+    int headerIndex = layoutIndexOf(function, loop.header);
+    if (headerIndex <= 0) {
+        return nullptr; // Entry block can't be a hoist target's successor
+    }
+
+    // Every jump to the header's label must come from inside the loop
+    // (back edges); outside-in entry must be pure fallthrough.
+    for (IRBasicBlock* pred : loop.header->getPredecessors()) {
+        if (loop.blocks.count(pred) != 0) {
+            continue; // In-loop predecessor (back edge)
+        }
+        const auto& insts = pred->getInstructions();
+        if (insts.empty()) {
+            continue;
+        }
+        IROpcode last = insts.back()->getOpcode();
+        if (last == IROpcode::JUMP || last == IROpcode::JUMP_IF_FALSE) {
+            const std::string& target =
+                (last == IROpcode::JUMP)
+                    ? static_cast<const JumpInst*>(insts.back().get())
+                          ->getTargetLabel()
+                    : static_cast<const JumpIfFalseInst*>(insts.back().get())
+                          ->getTargetLabel();
+            if (function->getBlockForLabel(target) == loop.header) {
+                return nullptr; // Jumps into the header from outside
+            }
+        }
+    }
 
-    // Run common subexpression elimination pass
-    commonSubexpressionEliminationPass(function);
+    auto& blocks = const_cast<std::vector<std::unique_ptr<IRBasicBlock>>&>(
+        function->getBasicBlocks());
+    auto preheader = std::make_unique<IRBasicBlock>(
+        loop.header->getLabel() + "_preheader");
+    IRBasicBlock* result = preheader.get();
+    blocks.insert(blocks.begin() + headerIndex, std::move(preheader));
+    return result;
+}
 
-    // Run dead code elimination pass
-    deadCodeEliminationPass(function);
+// Count how many times each value id is defined within the given blocks
+std::unordered_map<ValueId, int>
+countDefsIn(const std::unordered_set<IRBasicBlock*>& blocks)
+{
+    std::unordered_map<ValueId, int> defs;
+    for (const IRBasicBlock* block : blocks) {
+        for (const auto& inst : block->getInstructions()) {
+            if (inst->getResult() != nullptr) {
+                defs[inst->getResult()->getId()]++;
+            }
+        }
+    }
+    return defs;
 }
 
-void IROptimizer::optimize(std::vector<std::unique_ptr<IRFunction>>& functions)
+// Integer constant parse for strength reduction
+bool parseIntConstant(const IROperand& operand, long long& value)
+{
+    if (!operand.isConstant()) {
+        return false;
+    }
+    try {
+        value = std::stoll(operand.getConstant());
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Loop-Invariant Code Motion
+// ============================================================================
+// Hoists ADD/SUB/MUL instructions whose operands are constants or values
+// never defined inside the loop (and whose result is defined exactly once
+// in the function) into the loop's preheader. DIV/MOD stay put: hoisting
+// them could introduce a fault on a trip count of zero.
+
+int IROptimizer::loopInvariantCodeMotionPass(IRFunction* function)
 {
+    int totalHoisted = 0;
+
+    function->buildCFG();
+    function->computeDominators();
+
+    // Function-wide def counts for the single-def (SSA) check
+    std::unordered_set<IRBasicBlock*> allBlocks;
+    for (const auto& block : function->getBasicBlocks()) {
+        allBlocks.insert(block.get());
+    }
+    auto functionDefs = countDefsIn(allBlocks);
+
+    for (const NaturalLoop& loop : findNaturalLoops(function)) {
+        IRBasicBlock* preheader = getOrCreatePreheader(function, loop);
+        if (preheader == nullptr) {
+            continue;
+        }
+
+        auto loopDefs = countDefsIn(loop.blocks);
+
+        auto isInvariantOperand = [&](const IROperand& operand) {
+            if (operand.isConstant()) {
+                return true;
+            }
+            if (!operand.isSSAValue()) {
+                return false;
+            }
+            ValueId id = operand.getSSAValue().getId();
+            // Invariant iff never (re)defined inside the loop
+            return loopDefs.find(id) == loopDefs.end();
+        };
+
+        // Iterate to a fixpoint: hoisting one instruction can make a
+        // dependent one invariant.
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (IRBasicBlock* block : loop.blocks) {
+                auto& instructions = block->getInstructions();
+                for (size_t i = 0; i < instructions.size();) {
+                    IRInstruction* inst = instructions[i].get();
+                    IROpcode opcode = inst->getOpcode();
+                    bool hoistable =
+                        (opcode == IROpcode::ADD || opcode == IROpcode::SUB ||
+                         opcode == IROpcode::MUL) &&
+                        inst->getResult() != nullptr &&
+                        functionDefs[inst->getResult()->getId()] == 1 &&
+                        inst->getOperands().size() == 2 &&
+                        isInvariantOperand(inst->getOperands()[0]) &&
+                        isInvariantOperand(inst->getOperands()[1]);
+                    if (!hoistable) {
+                        ++i;
+                        continue;
+                    }
+
+                    // Move the instruction to the preheader; its result is
+                    // no longer defined in the loop, unlocking dependents.
+                    loopDefs.erase(inst->getResult()->getId());
+                    preheader->addInstruction(std::move(instructions[i]));
+                    instructions.erase(instructions.begin() + i);
+                    totalHoisted++;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    if (totalHoisted > 0) {
+        function->buildCFG(); // Block list changed (preheaders inserted)
+        function->computeDominators();
+    }
+    return totalHoisted;
+}
+
+// ============================================================================
+// Induction-Variable Strength Reduction
+// ============================================================================
+// IRCodeGenerator lowers "i = i + 1" through temporaries:
+//
+//   tC = MOVE <step>          (constant materialization)
+//   tK = ADD  i, tC
+//   i  = MOVE tK              <- the commit point of the increment
+//
+// and multiplies the same way (tM = MOVE <c>; tX = MUL i, tM). The pass
+// traces constants through such single-def temps, recognizes i as a basic
+// induction variable (exactly one in-loop definition, the MOVE above),
+// and rewrites a pre-increment tX = i * c into an accumulator: the
+// preheader computes the initial product with an immediate operand (the
+// constant temp is not available there) and tX advances by step*c right
+// after the increment commits. Only applied when every in-loop use of tX
+// precedes the increment and nothing reads tX outside the loop, so the
+// accumulator always holds i*c at its uses.
+
+int IROptimizer::strengthReductionPass(IRFunction* function)
+{
+    int totalReduced = 0;
+
+    function->buildCFG();
+    function->computeDominators();
+
+    std::unordered_set<IRBasicBlock*> allBlocks;
+    for (const auto& block : function->getBasicBlocks()) {
+        allBlocks.insert(block.get());
+    }
+    auto functionDefs = countDefsIn(allBlocks);
+
+    // Constants reachable through single-def "t = MOVE <literal>" temps
+    std::unordered_map<ValueId, long long> constOf;
+    for (const auto& block : function->getBasicBlocks()) {
+        for (const auto& inst : block->getInstructions()) {
+            long long value = 0;
+            if (inst->getOpcode() == IROpcode::MOVE &&
+                inst->getResult() != nullptr &&
+                inst->getOperands().size() == 1 &&
+                parseIntConstant(inst->getOperands()[0], value) &&
+                functionDefs[inst->getResult()->getId()] == 1) {
+                constOf[inst->getResult()->getId()] = value;
+            }
+        }
+    }
+
+    // Constant behind an operand: a literal or a traced constant temp
+    auto operandConstant = [&](const IROperand& operand, long long& value) {
+        if (parseIntConstant(operand, value)) {
+            return true;
+        }
+        if (operand.isSSAValue()) {
+            auto it = constOf.find(operand.getSSAValue().getId());
+            if (it != constOf.end()) {
+                value = it->second;
+                return true;
+            }
+        }
+        return false;
+    };
+
+    for (const NaturalLoop& loop : findNaturalLoops(function)) {
+        // Linearize the loop body in layout order for position checks
+        struct InstRef
+        {
+            IRBasicBlock* block;
+            size_t index;
+            IRInstruction* inst;
+        };
+        std::vector<InstRef> body;
+        for (const auto& block : function->getBasicBlocks()) {
+            if (loop.blocks.count(block.get()) == 0) {
+                continue;
+            }
+            auto& insts = block->getInstructions();
+            for (size_t i = 0; i < insts.size(); ++i) {
+                body.push_back({block.get(), i, insts[i].get()});
+            }
+        }
+
+        auto loopDefs = countDefsIn(loop.blocks);
+
+        // In-loop defining ADD per value id (for tracing iv = MOVE tK)
+        std::unordered_map<ValueId, const IRInstruction*> addDefs;
+        for (const InstRef& ref : body) {
+            if (ref.inst->getOpcode() == IROpcode::ADD &&
+                ref.inst->getResult() != nullptr) {
+                addDefs[ref.inst->getResult()->getId()] = ref.inst;
+            }
+        }
+
+        // Basic induction variables: one in-loop def "iv = MOVE tK" where
+        // tK = ADD iv, <const>. Keyed by iv's id; value is the increment's
+        // commit position and step.
+        struct Induction
+        {
+            size_t position; // Body position of "iv = MOVE tK"
+            long long step;
+        };
+        std::unordered_map<ValueId, Induction> inductions;
+        for (size_t pos = 0; pos < body.size(); ++pos) {
+            IRInstruction* inst = body[pos].inst;
+            if (inst->getOpcode() != IROpcode::MOVE ||
+                inst->getResult() == nullptr ||
+                inst->getOperands().size() != 1 ||
+                !inst->getOperands()[0].isSSAValue()) {
+                continue;
+            }
+            ValueId iv = inst->getResult()->getId();
+            if (loopDefs[iv] != 1) {
+                continue; // Redefined elsewhere in the loop
+            }
+            auto addIt =
+                addDefs.find(inst->getOperands()[0].getSSAValue().getId());
+            if (addIt == addDefs.end()) {
+                continue;
+            }
+            const auto& addOps = addIt->second->getOperands();
+            if (addOps.size() != 2) {
+                continue;
+            }
+            long long step = 0;
+            bool selfAdd =
+                (addOps[0].isSSAValue() &&
+                 addOps[0].getSSAValue().getId() == iv &&
+                 operandConstant(addOps[1], step)) ||
+                (addOps[1].isSSAValue() &&
+                 addOps[1].getSSAValue().getId() == iv &&
+                 operandConstant(addOps[0], step));
+            if (selfAdd) {
+                inductions[iv] = {pos, step};
+            }
+        }
+        if (inductions.empty()) {
+            continue;
+        }
+
+        // Find reducible multiplies: tX = MUL iv, <const> before the
+        // increment commits, with every use of tX also before it and no
+        // use outside the loop.
+        for (size_t pos = 0; pos < body.size(); ++pos) {
+            IRInstruction* inst = body[pos].inst;
+            if (inst->getOpcode() != IROpcode::MUL ||
+                inst->getResult() == nullptr ||
+                inst->getOperands().size() != 2) {
+                continue;
+            }
+            SSAValue* result = inst->getResult();
+            if (functionDefs[result->getId()] != 1) {
+                continue;
+            }
+
+            const auto& ops = inst->getOperands();
+            long long factor = 0;
+            const SSAValue* iv = nullptr;
+            if (ops[0].isSSAValue() && operandConstant(ops[1], factor) &&
+                inductions.count(ops[0].getSSAValue().getId()) != 0) {
+                iv = &ops[0].getSSAValue();
+            } else if (ops[1].isSSAValue() &&
+                       operandConstant(ops[0], factor) &&
+                       inductions.count(ops[1].getSSAValue().getId()) != 0) {
+                iv = &ops[1].getSSAValue();
+            }
+            if (iv == nullptr) {
+                continue;
+            }
+            const Induction& induction = inductions[iv->getId()];
+            if (pos >= induction.position) {
+                continue; // Multiply after the increment commits
+            }
+
+            // Every read of tX must sit between the multiply and the
+            // increment (the accumulator changes value at the increment),
+            // and nothing outside the loop may read it.
+            bool usesSafe = true;
+            for (const auto& block : function->getBasicBlocks()) {
+                bool inLoop = loop.blocks.count(block.get()) != 0;
+                for (const auto& other : block->getInstructions()) {
+                    for (const auto& operand : other->getOperands()) {
+                        if (!operand.isSSAValue() ||
+                            operand.getSSAValue().getId() != result->getId()) {
+                            continue;
+                        }
+                        if (!inLoop) {
+                            usesSafe = false;
+                            break;
+                        }
+                    }
+                }
+            }
+            for (size_t usePos = induction.position;
+                 usePos < body.size() && usesSafe; ++usePos) {
+                for (const auto& operand : body[usePos].inst->getOperands()) {
+                    if (operand.isSSAValue() &&
+                        operand.getSSAValue().getId() == result->getId()) {
+                        usesSafe = false;
+                        break;
+                    }
+                }
+            }
+            if (!usesSafe) {
+                continue;
+            }
+
+            IRBasicBlock* preheader = getOrCreatePreheader(function, loop);
+            if (preheader == nullptr) {
+                break; // Entry shape unsupported; skip this loop entirely
+            }
+
+            // Preheader: tX = iv * c, with the factor as an immediate (the
+            // constant temp is only defined inside the loop)
+            preheader->addInstruction(std::make_unique<ArithmeticInst>(
+                IROpcode::MUL, result, IROperand(*iv),
+                IROperand(std::to_string(factor),
+                          IROperand::OperandType::CONSTANT)));
+
+            // After the increment commits: tX = tX + step*c
+            long long delta = induction.step * factor;
+            InstRef incRef = body[induction.position];
+            auto& incInsts = incRef.block->getInstructions();
+            incInsts.insert(
+                incInsts.begin() + incRef.index + 1,
+                std::make_unique<ArithmeticInst>(
+                    IROpcode::ADD, result, IROperand(*result),
+                    IROperand(std::to_string(delta),
+                              IROperand::OperandType::CONSTANT)));
+
+            // Remove the original in-loop multiply
+            auto& mulInsts = body[pos].block->getInstructions();
+            mulInsts.erase(mulInsts.begin() + body[pos].index);
+
+            totalReduced++;
+            // Positions in `body` are now stale; redo this loop on the
+            // next optimize() run rather than tracking shifts here.
+            break;
+        }
+    }
+
+    if (totalReduced > 0) {
+        function->buildCFG();
+        function->computeDominators();
+    }
+    return totalReduced;
+}
+
+// ============================================================================
+// Function Inlining
+// ============================================================================
+// Clones small, straight-line callee bodies into their callers: parameter
+// captures become moves of the argument operands, every value the callee
+// defines is renamed to a fresh inl<N>_ name, and the trailing return
+// becomes a move into the call's result. Constant folding, CSE and DCE
+// then clean up the expanded code. Whole-module by nature, so it runs
+// from the vector overload of optimize() before the per-function passes.
+
+namespace {
+
+// Maximum callee size (instructions) considered worth inlining
+constexpr size_t kInlineInstructionLimit = 12;
+
+// True if the function is a safe inline candidate: small, no control
+// flow (labels/jumps/phis), no self-recursion, and its only RETURN is the
+// final instruction.
+bool isInlinableCallee(const IRFunction* callee)
+{
+    if (callee->getIsExtern()) {
+        return false;
+    }
+    size_t instructionCount = 0;
+    const IRInstruction* last = nullptr;
+    for (const auto& block : callee->getBasicBlocks()) {
+        for (const auto& inst : block->getInstructions()) {
+            instructionCount++;
+            last = inst.get();
+            switch (inst->getOpcode()) {
+            case IROpcode::LABEL:
+            case IROpcode::JUMP:
+            case IROpcode::JUMP_IF_FALSE:
+            case IROpcode::PHI:
+                return false; // Control flow: cloning would need label renaming
+            case IROpcode::RETURN:
+                break; // Checked below: must be the last instruction
+            case IROpcode::CALL:
+                if (static_cast<const CallInst*>(inst.get())->getFunctionName() ==
+                    callee->getName()) {
+                    return false; // Direct recursion
+                }
+                break;
+            default:
+                break;
+            }
+        }
+    }
+    if (instructionCount == 0 || instructionCount > kInlineInstructionLimit) {
+        return false;
+    }
+    // A single trailing return keeps the clone straight-line
+    for (const auto& block : callee->getBasicBlocks()) {
+        for (const auto& inst : block->getInstructions()) {
+            if (inst->getOpcode() == IROpcode::RETURN && inst.get() != last) {
+                return false;
+            }
+        }
+    }
+    return last != nullptr && last->getOpcode() == IROpcode::RETURN;
+}
+
+} // namespace
+
+int IROptimizer::inlineFunctionsPass(
+    std::vector<std::unique_ptr<IRFunction>>& functions)
+{
+    int totalInlined = 0;
+
+    // Callee lookup by name, filtered to inlinable candidates
+    std::unordered_map<std::string, IRFunction*> candidates;
+    for (const auto& function : functions) {
+        if (isInlinableCallee(function.get())) {
+            candidates[function->getName()] = function.get();
+        }
+    }
+    if (candidates.empty()) {
+        return 0;
+    }
+
     for (auto& function : functions) {
-        optimize(function.get());
+        for (const auto& block : function->getBasicBlocks()) {
+            auto& instructions =
+                const_cast<IRBasicBlock*>(block.get())->getInstructions();
+            for (size_t i = 0; i < instructions.size(); ++i) {
+                if (instructions[i]->getOpcode() != IROpcode::CALL) {
+                    continue;
+                }
+                auto* call = static_cast<CallInst*>(instructions[i].get());
+                auto calleeIt = candidates.find(call->getFunctionName());
+                if (calleeIt == candidates.end() ||
+                    calleeIt->second == function.get()) {
+                    continue; // Unknown callee or self-call
+                }
+                IRFunction* callee = calleeIt->second;
+
+                // Map callee parameter indices to the call's argument
+                // operands; bail if counts mismatch.
+                const auto& args = call->getOperands();
+
+                // Per-site remap: callee-defined value id -> fresh value
+                std::unordered_map<ValueId, SSAValue*> renamed;
+                std::string prefix =
+                    "inl" + std::to_string(inlineNameCounter_++) + "_";
+                auto freshValue = [&](const SSAValue& original) {
+                    auto it = renamed.find(original.getId());
+                    if (it != renamed.end()) {
+                        return it->second;
+                    }
+                    SSAValue* fresh =
+                        new SSAValue(prefix + original.getName(),
+                                     original.getType(), original.getVersion());
+                    renamed[original.getId()] = fresh;
+                    return fresh;
+                };
+                auto remapOperand = [&](const IROperand& operand) {
+                    if (operand.isSSAValue()) {
+                        auto it = renamed.find(operand.getSSAValue().getId());
+                        if (it != renamed.end()) {
+                            return IROperand(*it->second);
+                        }
+                    }
+                    return operand;
+                };
+
+                // Clone the callee body
+                std::vector<std::unique_ptr<IRInstruction>> cloned;
+                bool ok = true;
+                for (const auto& calleeBlock : callee->getBasicBlocks()) {
+                    for (const auto& inst : calleeBlock->getInstructions()) {
+                        IROpcode opcode = inst->getOpcode();
+                        SSAValue* result =
+                            inst->getResult() != nullptr
+                                ? freshValue(*inst->getResult())
+                                : nullptr;
+                        const auto& ops = inst->getOperands();
+
+                        switch (opcode) {
+                        case IROpcode::PARAM: {
+                            int index = static_cast<const ParamInst*>(inst.get())
+                                            ->getParamIndex();
+                            if (index < 0 ||
+                                static_cast<size_t>(index) >= args.size()) {
+                                ok = false;
+                                break;
+                            }
+                            // Capture the argument into the renamed param
+                            cloned.push_back(std::make_unique<MoveInst>(
+                                result, args[index]));
+                            break;
+                        }
+                        case IROpcode::ADD:
+                        case IROpcode::SUB:
+                        case IROpcode::MUL:
+                        case IROpcode::DIV:
+                        case IROpcode::MOD:
+                            cloned.push_back(std::make_unique<ArithmeticInst>(
+                                opcode, result, remapOperand(ops[0]),
+                                remapOperand(ops[1])));
+                            break;
+                        case IROpcode::EQ:
+                        case IROpcode::NE:
+                        case IROpcode::LT:
+                        case IROpcode::GT:
+                        case IROpcode::LE:
+                        case IROpcode::GE:
+                            cloned.push_back(std::make_unique<ComparisonInst>(
+                                opcode, result, remapOperand(ops[0]),
+                                remapOperand(ops[1])));
+                            break;
+                        case IROpcode::MOVE:
+                            cloned.push_back(std::make_unique<MoveInst>(
+                                result, remapOperand(ops[0])));
+                            break;
+                        case IROpcode::LOAD:
+                            cloned.push_back(std::make_unique<LoadInst>(
+                                result, remapOperand(ops[0])));
+                            break;
+                        case IROpcode::STORE:
+                            cloned.push_back(std::make_unique<StoreInst>(
+                                remapOperand(ops[0]), remapOperand(ops[1])));
+                            break;
+                        case IROpcode::CALL: {
+                            const auto* nested =
+                                static_cast<const CallInst*>(inst.get());
+                            auto clonedCall = std::make_unique<CallInst>(
+                                nested->getFunctionName(), result);
+                            for (const auto& arg : ops) {
+                                clonedCall->addArgument(remapOperand(arg));
+                            }
+                            cloned.push_back(std::move(clonedCall));
+                            break;
+                        }
+                        case IROpcode::RETURN:
+                            // Trailing return: move the value into the
+                            // call's result (if either side has one)
+                            if (call->getResult() != nullptr && !ops.empty()) {
+                                cloned.push_back(std::make_unique<MoveInst>(
+                                    call->getResult(), remapOperand(ops[0])));
+                            }
+                            break;
+                        default:
+                            ok = false;
+                            break;
+                        }
+                        if (!ok) {
+                            break;
+                        }
+                    }
+                    if (!ok) {
+                        break;
+                    }
+                }
+                if (!ok) {
+                    continue; // Leave the call as-is
+                }
+
+                // Splice the clone in place of the CallInst
+                instructions.erase(instructions.begin() + i);
+                instructions.insert(instructions.begin() + i,
+                                    std::make_move_iterator(cloned.begin()),
+                                    std::make_move_iterator(cloned.end()));
+                i += cloned.size() - 1;
+                totalInlined++;
+            }
+        }
+    }
+
+    inliningCount += totalInlined;
+    return totalInlined;
+}
+
+// ============================================================================
+// Optimization Pipeline
+// ============================================================================
+
+void IROptimizer::optimize(IRFunction* function)
+{
+    // Build the CFG and dominator tree first: splitting the linear stream
+    // into real basic blocks also keeps the block-local passes honest (no
+    // folding or CSE across a label that something jumps to).
+    function->buildCFG();
+    function->computeDominators();
+
+    // Run the registered pipeline with per-pass statistics
+    passManager_.run(function);
+}
+
+void IROptimizer::optimize(std::vector<std::unique_ptr<IRFunction>>& functions)
+{
+    // Inline small callees first so the per-function passes see and clean
+    // up the expanded bodies (whole-module, must precede the fan-out)
+    inlineFunctionsPass(functions);
+
+    // Each IRFunction is optimized independently, so fan the list out over
+    // a worker pool. Every worker gets its own IROptimizer (and thus its
+    // own counters and pass statistics); results are merged into this
+    // instance after the join, keeping the external view identical to a
+    // serial run.
+    size_t workerCount = std::thread::hardware_concurrency();
+    if (workerCount == 0) {
+        workerCount = 1;
+    }
+    if (workerCount > functions.size()) {
+        workerCount = functions.size();
+    }
+
+    if (workerCount <= 1) {
+        for (auto& function : functions) {
+            optimize(function.get());
+        }
+        return;
+    }
+
+    std::vector<IROptimizer> workers(workerCount);
+    std::atomic<size_t> nextFunction{0};
+
+    std::vector<std::thread> threads;
+    threads.reserve(workerCount);
+    for (size_t w = 0; w < workerCount; ++w) {
+        threads.emplace_back([&, w]() {
+            for (size_t i = nextFunction.fetch_add(1); i < functions.size();
+                 i = nextFunction.fetch_add(1)) {
+                workers[w].optimize(functions[i].get());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Deterministic merge of per-worker statistics
+    for (const IROptimizer& worker : workers) {
+        constantFoldingCount += worker.constantFoldingCount;
+        deadCodeEliminationCount += worker.deadCodeEliminationCount;
+        cseCount += worker.cseCount;
+        passManager_.mergeStatistics(worker.passManager_);
     }
 }
 
@@ -387,6 +1323,7 @@ void IROptimizer::optimize(std::vector<std::unique_ptr<IRFunction>>& functions)
 
 void IROptimizer::resetStatistics()
 {
+    inliningCount = 0;
     constantFoldingCount = 0;
     deadCodeEliminationCount = 0;
     cseCount = 0;
@@ -397,6 +1334,7 @@ void IROptimizer::printOptimizationReport() const
     std::cout << "========================================\n";
     std::cout << "IR Optimization Report\n";
     std::cout << "========================================\n";
+    std::cout << "Function Inlining:             " << inliningCount << " call sites\n";
     std::cout << "Constant Folding:              " << constantFoldingCount << " optimizations\n";
     std::cout << "Dead Code Elimination:         " << deadCodeEliminationCount << " optimizations\n";
     std::cout << "Common Subexpression Elim.:    " << cseCount << " optimizations\n";
@@ -2,6 +2,57 @@
 #include <string>    // For std::string, std::stoi
 #include <stdexcept> // For exception handling
 #include <cctype>    // For std::isdigit, std::isalpha, etc.
+#include <cstring>   // For std::memcpy, std::memchr (bulk scanning)
+
+// --- SWAR Helpers ---
+// The bulk-scanning kernels process 8 source bytes at a time packed into a
+// uint64_t ("SIMD within a register"). On x86-64 the loads compile to a
+// single unaligned MOV, so runs of identifiers/digits/whitespace cost
+// roughly one table probe per byte with an 8-byte early-exit granularity.
+namespace
+{
+    inline uint64_t load_word(const char *p)
+    {
+        uint64_t w;
+        std::memcpy(&w, p, sizeof(w)); // Single unaligned load after opt
+        return w;
+    }
+    inline uint64_t broadcast(unsigned char c)
+    {
+        return 0x0101010101010101ULL * c;
+    }
+    // Returns a word with 0x80 set in the high bit of every byte of `w`
+    // equal to `c` (classic "haszero" bit trick).
+    inline uint64_t bytes_eq(uint64_t w, unsigned char c)
+    {
+        uint64_t x = w ^ broadcast(c);
+        return (x - 0x0101010101010101ULL) & ~x & 0x8080808080808080ULL;
+    }
+}
+
+// --- Character Class Table ---
+// One byte per character; see CharClassBit in lexer.h for the bit layout
+// (0x01 ident-start, 0x02 ident-char, 0x04 digit, 0x08 hex digit, 0x10
+// whitespace-except-newline). Indexed branch-free by the scanning kernels.
+const unsigned char Lexer::kCharClass[256] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, // 0x00-0x0F
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x10-0x1F
+    0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x20-0x2F
+    0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x30-0x3F
+    0x00, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, // 0x40-0x4F
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x03, // 0x50-0x5F
+    0x00, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, // 0x60-0x6F
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x70-0x7F
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x80-0x8F
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x90-0x9F
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0xA0-0xAF
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0xB0-0xBF
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0xC0-0xCF
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0xD0-0xDF
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0xE0-0xEF
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00  // 0xF0-0xFF
+};
+
 
 // Constructor: Stores the source string and creates a view into it
 Lexer::Lexer(const std::string &source, const std::string &initial_filename)
@@ -18,6 +69,23 @@ Lexer::Lexer(const std::string &source, const std::string &initial_filename)
     error_handler_.register_source(initial_filename, source_);
 }
 
+// Zero-copy constructor: scans the caller's buffer in place (e.g. an
+// mmap-backed SourceBuffer). source_ stays empty; only source_view_ is used.
+Lexer::Lexer(std::string_view source, const std::string &initial_filename)
+    : source_(), // No owned copy in this mode
+      source_view_(source),
+      current_pos_(0),
+      current_line_(1),
+      current_column_(1),
+      current_filename_(initial_filename),
+      error_handler_()
+{
+    error_handler_.set_max_errors(MAX_ERRORS);
+    // Zero-copy registration: the caller keeps the buffer alive for the
+    // lexer's lifetime, so the registry can hold a view into it.
+    error_handler_.register_source(initial_filename, source);
+}
+
 // Reset lexer position to the beginning (for re-use after lexAll())
 void Lexer::reset()
 {
@@ -47,20 +115,93 @@ char Lexer::advance()
     return current_char;
 }
 
-void Lexer::skipWhitespace()
+// --- Bulk Scanning Kernels ---
+
+// Length of the run of bytes at `pos` all carrying `mask` in the class
+// table. Processes 8 bytes per iteration and bails out of the wide loop as
+// soon as any byte in the chunk fails the class test.
+size_t Lexer::runLength(size_t pos, unsigned char mask) const
 {
-    while (true)
+    const char *data = source_view_.data();
+    const size_t len = source_view_.length();
+    size_t p = pos;
+
+    // Wide loop: probe 8 bytes per iteration.
+    while (p + 8 <= len)
     {
-        char c = peek();
-        if (c == ' ' || c == '\t' || c == '\r')
-        { // Skip space, tab, cr
-            advance();
+        unsigned char combined =
+            kCharClass[static_cast<unsigned char>(data[p])] &
+            kCharClass[static_cast<unsigned char>(data[p + 1])] &
+            kCharClass[static_cast<unsigned char>(data[p + 2])] &
+            kCharClass[static_cast<unsigned char>(data[p + 3])] &
+            kCharClass[static_cast<unsigned char>(data[p + 4])] &
+            kCharClass[static_cast<unsigned char>(data[p + 5])] &
+            kCharClass[static_cast<unsigned char>(data[p + 6])] &
+            kCharClass[static_cast<unsigned char>(data[p + 7])];
+        if ((combined & mask) == 0)
+        {
+            break; // Some byte in this chunk ends the run
         }
-        else
+        p += 8;
+    }
+    // Scalar tail: find the exact end of the run.
+    while (p < len && (kCharClass[static_cast<unsigned char>(data[p])] & mask))
+    {
+        ++p;
+    }
+    return p - pos;
+}
+
+// Advance to absolute position `pos`, recounting line/column across the
+// skipped span. Used after memchr-style skips that may cross newlines.
+void Lexer::advanceTo(size_t pos)
+{
+    const char *data = source_view_.data();
+    size_t last_newline = source_view_.npos;
+    for (size_t p = current_pos_; p < pos; ++p)
+    {
+        if (data[p] == '\n')
         {
-            break;
+            ++current_line_;
+            last_newline = p;
+        }
+    }
+    if (last_newline == source_view_.npos)
+    {
+        current_column_ += static_cast<int>(pos - current_pos_);
+    }
+    else
+    {
+        current_column_ = static_cast<int>(pos - last_newline);
+    }
+    current_pos_ = pos;
+}
+
+void Lexer::skipWhitespace()
+{
+    const char *data = source_view_.data();
+    const size_t len = source_view_.length();
+    size_t p = current_pos_;
+
+    // SWAR loop: consume 8 bytes at a time while every byte is a space,
+    // tab or carriage return. bytes_eq marks matching bytes with 0x80 in
+    // their high bit, so a fully-set 0x8080... pattern means "all 8 match".
+    while (p + 8 <= len)
+    {
+        uint64_t w = load_word(data + p);
+        uint64_t ws = bytes_eq(w, ' ') | bytes_eq(w, '\t') | bytes_eq(w, '\r');
+        if (ws != 0x8080808080808080ULL)
+        {
+            break; // Chunk contains a non-whitespace byte
         }
+        p += 8;
     }
+    // Scalar tail via the class table.
+    while (p < len && (kCharClass[static_cast<unsigned char>(data[p])] & CC_WS))
+    {
+        ++p;
+    }
+    advanceBy(p - current_pos_); // Run contains no '\n' by construction
 }
 
 // Skips C-style comments (// and /* */)
@@ -75,27 +216,27 @@ void Lexer::skipComment()
     else if (peek() == '*')
     {              // Multi-line comment
         advance(); // Consume '*'
+        // Bulk-scan the comment body: memchr jumps straight to each '*'
+        // candidate (vectorized in libc), and advanceTo recounts the
+        // newlines in the skipped span to keep line/column exact.
+        const char *data = source_view_.data();
+        const size_t len = source_view_.length();
         while (true)
         {
-            if (peek() == '\0')
-                break; // Unterminated
-            // --- CORRECTED: Check for '*' FIRST ---
-            if (peek() == '*')
+            const char *star = static_cast<const char *>(
+                std::memchr(data + current_pos_, '*', len - current_pos_));
+            if (star == nullptr)
             {
-                advance(); // Consume '*'
-                if (peek() == '/')
-                {              // Check if the NEXT char is '/'
-                    advance(); // Consume closing '/'
-                    break;     // End of comment
-                }
-                // If not '/', it was just a '*', continue loop
-                // (No need to put it back, already advanced)
+                advanceTo(len); // Unterminated: consume to EOF
+                break;
             }
-            else
+            size_t star_pos = static_cast<size_t>(star - data);
+            if (star_pos + 1 < len && data[star_pos + 1] == '/')
             {
-                advance(); // Consume char inside comment (handles newlines correctly)
+                advanceTo(star_pos + 2); // Consume body + closing */
+                break;
             }
-            // --- End Correction ---
+            advanceTo(star_pos + 1); // Lone '*', keep scanning
         }
     }
     // If neither '/' nor '*', the caller handles the single '/' operator
@@ -103,10 +244,13 @@ void Lexer::skipComment()
 
 void Lexer::skipRestOfLine()
 {
-    while (peek() != '\n' && peek() != '\0')
-    {
-        advance();
-    }
+    // memchr finds the terminating newline in one vectorized pass; the
+    // skipped span contains no '\n', so a column-only advance suffices.
+    const size_t len = source_view_.length();
+    const char *nl = static_cast<const char *>(
+        std::memchr(source_view_.data() + current_pos_, '\n', len - current_pos_));
+    size_t end = (nl != nullptr) ? static_cast<size_t>(nl - source_view_.data()) : len;
+    advanceBy(end - current_pos_);
 }
 
 // --- #line Directive Handling ---
@@ -358,14 +502,18 @@ Token Lexer::scanIdentifierOrKeyword(int start_line, int start_column)
 {
     string start_filename = current_filename_;
     size_t start_pos = current_pos_;
-    advance(); // First char already checked
-    while (is_identifier_char(peek()))
-    {
-        advance();
-    }
+    // First char already checked; consume the whole identifier run with the
+    // chunked kernel (identifier runs never contain a newline).
+    advanceBy(1 + runLength(start_pos + 1, CC_IDENT_CHAR));
 
     string_view value = source_view_.substr(start_pos, current_pos_ - start_pos);
     TokenType type = checkKeyword(value);
+    if (type == TokenType::IDENTIFIER)
+    {
+        // Canonicalize: repeated identifiers collapse to one stored copy,
+        // so tokens for the same name share a data() pointer.
+        value = interner_.intern(value);
+    }
     return Token(type, value, start_filename, start_line, start_column);
 }
 
@@ -389,10 +537,7 @@ Token Lexer::scanNumber(int start_line, int start_column)
                 string_view val = source_view_.substr(start_pos, current_pos_ - start_pos);
                 return Token(TokenType::UNKNOWN, val, start_filename, start_line, start_column);
             }
-            while (is_hex_digit(peek()))
-            {
-                advance();
-            }
+            advanceBy(runLength(current_pos_, CC_HEX_DIGIT));
         }
         else
         { // Octal or float 0.x
@@ -408,10 +553,7 @@ Token Lexer::scanNumber(int start_line, int start_column)
     }
     else if (is_digit(peek()))
     { // Decimal
-        while (is_digit(peek()))
-        {
-            advance();
-        }
+        advanceBy(runLength(current_pos_, CC_DIGIT));
     }
     else if (peek() == '.')
     { // Float starting with '.'
@@ -422,10 +564,7 @@ Token Lexer::scanNumber(int start_line, int start_column)
             string_view val = source_view_.substr(start_pos, current_pos_ - start_pos);
             return Token(TokenType::UNKNOWN, val, start_filename, start_line, start_column);
         }
-        while (is_digit(peek()))
-        {
-            advance();
-        }
+        advanceBy(runLength(current_pos_, CC_DIGIT));
     }
 
     // --- 2. Floating Point Parts ---
@@ -438,10 +577,7 @@ Token Lexer::scanNumber(int start_line, int start_column)
             {
                 type = TokenType::FLOAT_LITERAL;
                 advance();
-                while (is_digit(peek()))
-                {
-                    advance();
-                }
+                advanceBy(runLength(current_pos_, CC_DIGIT));
                 had_decimal = true;
             } // Else: second '.', let end check handle
         }
@@ -465,10 +601,7 @@ Token Lexer::scanNumber(int start_line, int start_column)
                     string_view val = source_view_.substr(start_pos, current_pos_ - start_pos);
                     return Token(TokenType::UNKNOWN, val, start_filename, start_line, start_column);
                 }
-                while (is_digit(peek()))
-                {
-                    advance();
-                }
+                advanceBy(runLength(current_pos_, CC_DIGIT));
             } // Else: 'e' not after digit/'.', let end check handle
         }
     }
@@ -808,19 +941,145 @@ Token Lexer::scanDelimiter(int start_line, int start_column)
     return Token(type, value, start_filename, start_line, start_column);
 }
 
-// Keyword lookup (needs string_view key or conversion)
+// Keyword classification: length-bucketed dispatch generated at compile
+// time. Each bucket switches on the first character and finishes with a
+// single string_view comparison (a constant-length memcmp after inlining),
+// so classifying an identifier costs a couple of branches and allocates
+// nothing — there is no hash table to build or probe.
 TokenType Lexer::checkKeyword(string_view value) const
 {
-    // Convert string_view to string for lookup
-    std::string key(value);
-    auto it = keywords_.find(key);
-    if (it != keywords_.end())
+    switch (value.length())
     {
-        return it->second; // It's a keyword
+    case 2:
+        if (value == "do")
+            return TokenType::KW_DO;
+        if (value == "if")
+            return TokenType::KW_IF;
+        break;
+    case 3:
+        if (value == "for")
+            return TokenType::KW_FOR;
+        if (value == "int")
+            return TokenType::KW_INT;
+        break;
+    case 4:
+        switch (value[0])
+        {
+        case 'a':
+            if (value == "auto")
+                return TokenType::KW_AUTO;
+            break;
+        case 'c':
+            if (value == "case")
+                return TokenType::KW_CASE;
+            if (value == "char")
+                return TokenType::KW_CHAR;
+            break;
+        case 'e':
+            if (value == "else")
+                return TokenType::KW_ELSE;
+            if (value == "enum")
+                return TokenType::KW_ENUM;
+            break;
+        case 'g':
+            if (value == "goto")
+                return TokenType::KW_GOTO;
+            break;
+        case 'l':
+            if (value == "long")
+                return TokenType::KW_LONG;
+            break;
+        case 'v':
+            if (value == "void")
+                return TokenType::KW_VOID;
+            break;
+        }
+        break;
+    case 5:
+        switch (value[0])
+        {
+        case 'b':
+            if (value == "break")
+                return TokenType::KW_BREAK;
+            break;
+        case 'c':
+            if (value == "const")
+                return TokenType::KW_CONST;
+            break;
+        case 'f':
+            if (value == "float")
+                return TokenType::KW_FLOAT;
+            break;
+        case 's':
+            if (value == "short")
+                return TokenType::KW_SHORT;
+            break;
+        case 'u':
+            if (value == "union")
+                return TokenType::KW_UNION;
+            break;
+        case 'w':
+            if (value == "while")
+                return TokenType::KW_WHILE;
+            break;
+        }
+        break;
+    case 6:
+        switch (value[0])
+        {
+        case 'd':
+            if (value == "double")
+                return TokenType::KW_DOUBLE;
+            break;
+        case 'e':
+            if (value == "extern")
+                return TokenType::KW_EXTERN;
+            break;
+        case 'r':
+            if (value == "return")
+                return TokenType::KW_RETURN;
+            break;
+        case 's':
+            if (value == "signed")
+                return TokenType::KW_SIGNED;
+            if (value == "sizeof")
+                return TokenType::KW_SIZEOF;
+            if (value == "static")
+                return TokenType::KW_STATIC;
+            if (value == "struct")
+                return TokenType::KW_STRUCT;
+            if (value == "switch")
+                return TokenType::KW_SWITCH;
+            break;
+        }
+        break;
+    case 7:
+        if (value == "default")
+            return TokenType::KW_DEFAULT;
+        if (value == "typedef")
+            return TokenType::KW_TYPEDEF;
+        break;
+    case 8:
+        switch (value[0])
+        {
+        case 'c':
+            if (value == "continue")
+                return TokenType::KW_CONTINUE;
+            break;
+        case 'r':
+            if (value == "register")
+                return TokenType::KW_REGISTER;
+            break;
+        case 'u':
+            if (value == "unsigned")
+                return TokenType::KW_UNSIGNED;
+            break;
+        case 'v':
+            if (value == "volatile")
+                return TokenType::KW_VOLATILE;
+            break;
+        }
+        break;
     }
     return TokenType::IDENTIFIER; // Not a keyword
-}
-
-// Static map definition (remains the same)
-const std::unordered_map<std::string, TokenType> Lexer::keywords_ = {
-    {"auto", TokenType::KW_AUTO}, {"break", TokenType::KW_BREAK}, {"case", TokenType::KW_CASE}, {"char", TokenType::KW_CHAR}, {"const", TokenType::KW_CONST}, {"continue", TokenType::KW_CONTINUE}, {"default", TokenType::KW_DEFAULT}, {"do", TokenType::KW_DO}, {"double", TokenType::KW_DOUBLE}, {"else", TokenType::KW_ELSE}, {"enum", TokenType::KW_ENUM}, {"extern", TokenType::KW_EXTERN}, {"float", TokenType::KW_FLOAT}, {"for", TokenType::KW_FOR}, {"goto", TokenType::KW_GOTO}, {"if", TokenType::KW_IF}, {"int", TokenType::KW_INT}, {"long", TokenType::KW_LONG}, {"register", TokenType::KW_REGISTER}, {"return", TokenType::KW_RETURN}, {"short", TokenType::KW_SHORT}, {"signed", TokenType::KW_SIGNED}, {"sizeof", TokenType::KW_SIZEOF}, {"static", TokenType::KW_STATIC}, {"struct", TokenType::KW_STRUCT}, {"switch", TokenType::KW_SWITCH}, {"typedef", TokenType::KW_TYPEDEF}, {"union", TokenType::KW_UNION}, {"unsigned", TokenType::KW_UNSIGNED}, {"void", TokenType::KW_VOID}, {"volatile", TokenType::KW_VOLATILE}, {"while", TokenType::KW_WHILE}};
\ No newline at end of file
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+#include "string_interner.h"
+
+std::string_view StringInterner::intern(std::string_view s)
+{
+    // Fast path: already interned, return the canonical view.
+    auto it = index_.find(s);
+    if (it != index_.end())
+    {
+        return *it;
+    }
+
+    // First sight: copy the bytes into stable storage and index the copy.
+    storage_.emplace_back(s);
+    std::string_view canonical(storage_.back());
+    index_.insert(canonical);
+    return canonical;
+}
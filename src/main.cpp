@@ -1,7 +1,6 @@
 #include "compiler_driver.h"
+#include "compile_server.h"
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <getopt.h>
 
 // ============================================================================
@@ -15,13 +14,21 @@ void printUsage(const char* programName) {
     std::cout << "  -S                  Compile only; do not assemble or link\n";
     std::cout << "  -c                  Compile and assemble, but do not link\n";
     std::cout << "  -O0                 Disable optimizations\n";
+    std::cout << "  -j <n>              Use <n> worker threads for multi-file compiles\n";
+    std::cout << "  --direct-obj        Emit ELF objects directly (skip the external assembler)\n";
+    std::cout << "  --regalloc <mode>   Register allocator: linear (default) or graph\n";
+    std::cout << "  --no-temp-files     Assemble and link via pipes/memfd (no temp .s/.o files)\n";
+    std::cout << "  --daemon <socket>   Run as a compile server on a Unix socket\n";
     std::cout << "  -v, --verbose       Enable verbose output\n";
     std::cout << "  -k, --keep          Keep intermediate files (.s, .o)\n";
     std::cout << "  -w                  Disable warnings\n";
     std::cout << "  --dump-tokens <file>  Dump token stream to JSON file\n";
+    std::cout << "  --dump-tokens-bin <file>  Dump token stream in binary MTK1 format\n";
     std::cout << "  --dump-ast <file>     Dump AST to JSON file\n";
     std::cout << "  --dump-asm <file>     Dump assembly to text file\n";
     std::cout << "  --dump-hex <file>     Dump hex output to file\n";
+    std::cout << "  --dump-opt-stats <file>  Dump per-pass optimizer statistics to JSON file\n";
+    std::cout << "  --dump-timing <file>  Dump per-phase timing and memory stats to JSON file\n";
     std::cout << "  -h, --help          Display this help message\n";
     std::cout << "\n";
     std::cout << "Example:\n";
@@ -42,13 +49,20 @@ int main(int argc, char* argv[]) {
         {"dump-ast",    required_argument, nullptr, 1001},
         {"dump-asm",    required_argument, nullptr, 1002},
         {"dump-hex",    required_argument, nullptr, 1003},
+        {"dump-opt-stats", required_argument, nullptr, 1004},
+        {"direct-obj",  no_argument,       nullptr, 1005},
+        {"no-temp-files", no_argument,     nullptr, 1006},
+        {"daemon",      required_argument, nullptr, 1007},
+        {"dump-timing", required_argument, nullptr, 1008},
+        {"dump-tokens-bin", required_argument, nullptr, 1009},
+        {"regalloc",    required_argument, nullptr, 1010},
         {nullptr,       0,                 nullptr, 0}
     };
 
     // Parse command-line arguments
     int opt;
     int option_index = 0;
-    while ((opt = getopt_long(argc, argv, "o:Scvkhw", long_options, &option_index)) != -1) {
+    while ((opt = getopt_long(argc, argv, "o:Scvkhwj:", long_options, &option_index)) != -1) {
         switch (opt) {
             case 'o':
                 options.outputFile = optarg;
@@ -68,6 +82,9 @@ int main(int argc, char* argv[]) {
             case 'w':
                 options.warningsEnabled = false;
                 break;
+            case 'j':
+                options.jobs = std::atoi(optarg);
+                break;
             case 1000:  // --dump-tokens
                 options.dumpTokensPath = optarg;
                 break;
@@ -80,6 +97,28 @@ int main(int argc, char* argv[]) {
             case 1003:  // --dump-hex
                 options.dumpHexPath = optarg;
                 break;
+            case 1004:  // --dump-opt-stats
+                options.dumpOptStatsPath = optarg;
+                break;
+            case 1005:  // --direct-obj
+                options.directObject = true;
+                break;
+            case 1006:  // --no-temp-files
+                options.noTempFiles = true;
+                break;
+            case 1007: { // --daemon <socket-path>
+                CompileServer server(optarg);
+                return server.run();
+            }
+            case 1008:  // --dump-timing
+                options.dumpTimingPath = optarg;
+                break;
+            case 1009:  // --dump-tokens-bin
+                options.dumpTokensBinPath = optarg;
+                break;
+            case 1010:  // --regalloc <linear|graph>
+                options.regalloc = optarg;
+                break;
             case 'h':
                 printUsage(argv[0]);
                 return 0;
@@ -96,23 +135,21 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    sourceFile = argv[optind];
-
-    // Read source file
-    std::ifstream inFile(sourceFile);
-    if (!inFile) {
-        std::cerr << "Error: Cannot open source file: " << sourceFile << std::endl;
-        return 1;
+    // Collect all positional arguments as source files
+    std::vector<std::string> sourceFiles;
+    for (int i = optind; i < argc; ++i) {
+        sourceFiles.push_back(argv[i]);
     }
+    sourceFile = sourceFiles.front();
 
-    std::stringstream buffer;
-    buffer << inFile.rdbuf();
-    std::string sourceCode = buffer.str();
-    inFile.close();
-
-    // Create compiler driver and compile
+    // Create compiler driver and compile. Single files go through
+    // compileFile(), which memory-maps the source so the lexer scans the
+    // page cache directly; multi-file batches run per-file pipelines on a
+    // worker pool and serialize only the final link.
     CompilerDriver driver(options);
-    bool success = driver.compile(sourceCode, sourceFile);
+    bool success = sourceFiles.size() == 1
+                       ? driver.compileFile(sourceFile)
+                       : driver.compileMultiple(sourceFiles);
 
     if (!success) {
         std::cerr << "\nCompilation failed with " << driver.getErrorCount() << " error(s)\n";
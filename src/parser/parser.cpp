@@ -4,10 +4,11 @@
 
 Parser::Parser(Lexer &lexer)
     : lexer_(lexer), current_token_(lexer_.getNextToken()) {
-  // Copy source code registration from Lexer's ErrorHandler for context display
+  // Share source registration from the Lexer's ErrorHandler for context
+  // display (views only; the lexer keeps the buffers alive)
   const auto &lexer_sources = lexer_.getErrorHandler().get_source_files();
   for (const auto &pair : lexer_sources) {
-    error_handler_.register_source(pair.first, pair.second);
+    error_handler_.register_source(pair.first, pair.second.text);
   }
 }
 
@@ -120,7 +121,7 @@ void Parser::synchronizeToDeclaration() {
 // Expression Parsing
 // ============================================================================
 
-std::unique_ptr<Expression> Parser::parseExpression() {
+Expression *Parser::parseExpression() {
   // Check for assignment: identifier = expression
   if (current_token_.type == TokenType::IDENTIFIER) {
     auto expr = parseBinaryExpression(0);
@@ -134,7 +135,7 @@ std::unique_ptr<Expression> Parser::parseExpression() {
 
       SourceLocation loc(assign_token.filename, assign_token.line,
                          assign_token.column);
-      return std::make_unique<AssignmentExpr>(std::move(expr), std::move(value),
+      return arena_.create<AssignmentExpr>(std::move(expr), std::move(value),
                                               loc);
     }
 
@@ -145,7 +146,7 @@ std::unique_ptr<Expression> Parser::parseExpression() {
   return parseBinaryExpression(0);
 }
 
-std::unique_ptr<Expression> Parser::parsePrimaryExpression() {
+Expression *Parser::parsePrimaryExpression() {
   // Primary expressions:
   // - Identifiers (variable/function names)
   // - Literals (numbers, strings, chars)
@@ -176,14 +177,14 @@ std::unique_ptr<Expression> Parser::parsePrimaryExpression() {
       consume(TokenType::RPAREN, "Expected ')' after sizeof type");
       SourceLocation loc(sizeof_token.filename, sizeof_token.line,
                          sizeof_token.column);
-      return std::make_unique<SizeOfExpr>(typeName, loc);
+      return arena_.create<SizeOfExpr>(typeName, loc);
     } else {
       // It's an expression: sizeof(var)
       auto expr = parseExpression();
       consume(TokenType::RPAREN, "Expected ')' after sizeof expression");
       SourceLocation loc(sizeof_token.filename, sizeof_token.line,
                          sizeof_token.column);
-      return std::make_unique<SizeOfExpr>(std::move(expr), loc);
+      return arena_.create<SizeOfExpr>(std::move(expr), loc);
     }
   }
 
@@ -229,7 +230,7 @@ std::unique_ptr<Expression> Parser::parsePrimaryExpression() {
         auto operand = parseUnaryExpression();
 
         SourceLocation loc = currentLocation(); // Approximation
-        return std::make_unique<TypeCastExpr>(std::move(operand), typeStr,
+        return arena_.create<TypeCastExpr>(std::move(operand), typeStr,
                                               false, loc);
       } else {
         // Not a cast, just (expression)
@@ -252,7 +253,7 @@ std::unique_ptr<Expression> Parser::parsePrimaryExpression() {
 // Identifier and Function Call Parsing
 // ============================================================================
 
-std::unique_ptr<Expression> Parser::parseIdentifier() {
+Expression *Parser::parseIdentifier() {
   // Accept: Creates IdentifierNode with variable name
   // Accept: Does NOT validate existence (that's semantic analysis later)
   // USER STORY #14: Also handles function calls when identifier is followed by
@@ -270,8 +271,8 @@ std::unique_ptr<Expression> Parser::parseIdentifier() {
                      identifier_token.column);
 
   // Create the base expression (identifier)
-  std::unique_ptr<Expression> expr =
-      std::make_unique<IdentifierExpr>(name, loc);
+  Expression *expr =
+      arena_.create<IdentifierExpr>(name, loc);
 
   // Handle postfix operations (function calls and array access)
   // These can be chained: arr[i](args) or func(args)[i]
@@ -281,7 +282,7 @@ std::unique_ptr<Expression> Parser::parseIdentifier() {
       consume(TokenType::LPAREN, "Expected '('");
 
       // Parse argument list
-      std::vector<std::unique_ptr<Expression>> arguments;
+      std::vector<Expression *> arguments;
 
       // Handle empty argument list
       if (!check(TokenType::RPAREN)) {
@@ -301,19 +302,18 @@ std::unique_ptr<Expression> Parser::parseIdentifier() {
       consume(TokenType::RPAREN, "Expected ')' after function arguments");
 
       // Create CallExpr with current expression as callee
-      expr = std::make_unique<CallExpr>(std::move(expr), std::move(arguments),
-                                        loc);
+      expr = arena_.create<CallExpr>(expr, arena_.makeSpan(arguments), loc);
     } else if (check(TokenType::LBRACKET)) {
       // USER STORY #17: Parse array access
       consume(TokenType::LBRACKET, "Expected '['");
 
       // Parse index expression
-      std::unique_ptr<Expression> index = parseExpression();
+      Expression *index = parseExpression();
 
       consume(TokenType::RBRACKET, "Expected ']' after array index");
 
       // Create ArrayAccessExpr with current expression as array
-      expr = std::make_unique<ArrayAccessExpr>(std::move(expr),
+      expr = arena_.create<ArrayAccessExpr>(std::move(expr),
                                                std::move(index), loc);
     } else if (check(TokenType::DOT) || check(TokenType::ARROW)) {
       // USER STORY #20: Parse member access (. or ->)
@@ -327,13 +327,13 @@ std::unique_ptr<Expression> Parser::parseIdentifier() {
       // Desugar arrow operator: expr->member becomes (*expr).member
       if (isArrow) {
         // Create unary expression (*expr)
-        expr = std::make_unique<UnaryExpr>("*", std::move(expr), true, loc);
+        expr = arena_.create<UnaryExpr>("*", std::move(expr), true, loc);
         // Now treat as dot access (isArrow = false)
         isArrow = false;
       }
 
       // Create MemberAccessExpr
-      expr = std::make_unique<MemberAccessExpr>(std::move(expr), memberName,
+      expr = arena_.create<MemberAccessExpr>(std::move(expr), memberName,
                                                 isArrow, loc);
     } else if (check(TokenType::OP_INC) || check(TokenType::OP_DEC)) {
       // Handle postfix increment/decrement (e.g., i++, i--)
@@ -341,7 +341,7 @@ std::unique_ptr<Expression> Parser::parseIdentifier() {
       advance(); // consume '++' or '--'
 
       // Create UnaryExpr with prefix=false for postfix
-      expr = std::make_unique<UnaryExpr>(op, std::move(expr), false, loc);
+      expr = arena_.create<UnaryExpr>(op, std::move(expr), false, loc);
     } else {
       // No more postfix operations
       break;
@@ -355,7 +355,7 @@ std::unique_ptr<Expression> Parser::parseIdentifier() {
 // Literal Parsing (Support method)
 // ============================================================================
 
-std::unique_ptr<Expression> Parser::parseLiteral() {
+Expression *Parser::parseLiteral() {
   Token literal_token = current_token_;
   advance();
 
@@ -393,14 +393,14 @@ std::unique_ptr<Expression> Parser::parseLiteral() {
 
   SourceLocation loc(literal_token.filename, literal_token.line,
                      literal_token.column);
-  return std::make_unique<LiteralExpr>(value, lit_type, loc);
+  return arena_.create<LiteralExpr>(value, lit_type, loc);
 }
 
 // ============================================================================
 // Binary Expression Parsing
 // ============================================================================
 
-std::unique_ptr<Expression> Parser::parseBinaryExpression(int min_precedence) {
+Expression *Parser::parseBinaryExpression(int min_precedence) {
   // Precedence Climbing Algorithm
   // Handles binary operators with correct precedence and left-to-right
   // associativity
@@ -429,7 +429,7 @@ std::unique_ptr<Expression> Parser::parseBinaryExpression(int min_precedence) {
     std::string op_string = tokenTypeToOperatorString(op_token.type);
     SourceLocation loc(op_token.filename, op_token.line, op_token.column);
 
-    left = std::make_unique<BinaryExpr>(std::move(left), op_string,
+    left = arena_.create<BinaryExpr>(std::move(left), op_string,
                                         std::move(right), loc);
   }
 
@@ -535,7 +535,7 @@ std::string Parser::tokenTypeToOperatorString(TokenType type) const {
 // Unary Expression Parsing
 // ============================================================================
 
-std::unique_ptr<Expression> Parser::parseUnaryExpression() {
+Expression *Parser::parseUnaryExpression() {
   Token op_token = current_token_;
   std::string op = tokenTypeToOperatorString(op_token.type);
   advance();
@@ -544,14 +544,14 @@ std::unique_ptr<Expression> Parser::parseUnaryExpression() {
   auto operand = parsePrimaryExpression();
 
   SourceLocation loc(op_token.filename, op_token.line, op_token.column);
-  return std::make_unique<UnaryExpr>(op, std::move(operand), true, loc);
+  return arena_.create<UnaryExpr>(op, std::move(operand), true, loc);
 }
 
 // ============================================================================
 // Parenthesized Expression Parsing
 // ============================================================================
 
-std::unique_ptr<Expression> Parser::parseParenthesizedExpression() {
+Expression *Parser::parseParenthesizedExpression() {
   consume(TokenType::LPAREN, "Expected '('");
   auto expr = parseExpression();
   consume(TokenType::RPAREN, "Expected ')'");
@@ -562,7 +562,7 @@ std::unique_ptr<Expression> Parser::parseParenthesizedExpression() {
 // Statement Parsing
 // ============================================================================
 
-std::unique_ptr<Statement> Parser::parseStatement() {
+Statement *Parser::parseStatement() {
   switch (current_token_.type) {
   case TokenType::KW_IF:
     return parseIfStatement();
@@ -585,7 +585,7 @@ std::unique_ptr<Statement> Parser::parseStatement() {
     consume(TokenType::SEMICOLON, "Expected ';' after 'break'");
     SourceLocation loc(break_token.filename, break_token.line,
                        break_token.column);
-    return std::make_unique<BreakStmt>(loc);
+    return arena_.create<BreakStmt>(loc);
   }
 
   case TokenType::KW_CONTINUE: {
@@ -594,7 +594,7 @@ std::unique_ptr<Statement> Parser::parseStatement() {
     consume(TokenType::SEMICOLON, "Expected ';' after 'continue'");
     SourceLocation loc(continue_token.filename, continue_token.line,
                        continue_token.column);
-    return std::make_unique<ContinueStmt>(loc);
+    return arena_.create<ContinueStmt>(loc);
   }
 
   default:
@@ -602,7 +602,7 @@ std::unique_ptr<Statement> Parser::parseStatement() {
   }
 }
 
-std::unique_ptr<Statement> Parser::parseIfStatement() {
+Statement *Parser::parseIfStatement() {
   Token if_token = current_token_;
   advance(); // consume 'if'
 
@@ -612,17 +612,17 @@ std::unique_ptr<Statement> Parser::parseIfStatement() {
 
   auto then_branch = parseStatement();
 
-  std::unique_ptr<Statement> else_branch = nullptr;
+  Statement *else_branch = nullptr;
   if (match(TokenType::KW_ELSE)) {
     else_branch = parseStatement();
   }
 
   SourceLocation loc(if_token.filename, if_token.line, if_token.column);
-  return std::make_unique<IfStmt>(std::move(condition), std::move(then_branch),
+  return arena_.create<IfStmt>(std::move(condition), std::move(then_branch),
                                   std::move(else_branch), loc);
 }
 
-std::unique_ptr<Statement> Parser::parseWhileStatement() {
+Statement *Parser::parseWhileStatement() {
   Token while_token = current_token_;
   advance(); // consume 'while'
 
@@ -634,11 +634,11 @@ std::unique_ptr<Statement> Parser::parseWhileStatement() {
 
   SourceLocation loc(while_token.filename, while_token.line,
                      while_token.column);
-  return std::make_unique<WhileStmt>(std::move(condition), std::move(body),
+  return arena_.create<WhileStmt>(std::move(condition), std::move(body),
                                      loc);
 }
 
-std::unique_ptr<Statement> Parser::parseForStatement() {
+Statement *Parser::parseForStatement() {
   // USER STORY #10: Parse for loops
   // Syntax: for (init; condition; update) statement
   // All parts are optional: for (;;) is an infinite loop
@@ -650,7 +650,7 @@ std::unique_ptr<Statement> Parser::parseForStatement() {
 
   // Parse initializer (optional)
   // Can be: variable declaration (int i = 0) or expression (i = 0) or empty
-  std::unique_ptr<Statement> initializer = nullptr;
+  Statement *initializer = nullptr;
 
   if (!check(TokenType::SEMICOLON)) {
     // Check if it's a declaration (starts with a type keyword)
@@ -660,7 +660,7 @@ std::unique_ptr<Statement> Parser::parseForStatement() {
       // Wrap declaration in an expression statement for AST consistency
       // Note: The VarDecl already consumes the semicolon
       initializer =
-          std::make_unique<ExpressionStmt>(nullptr, decl->getLocation());
+          arena_.create<ExpressionStmt>(nullptr, decl->getLocation());
       // For now, we'll store the declaration differently
       // This is a simplification - ideally we'd have a DeclStmt node
       // For this implementation, we'll parse it as an expression
@@ -669,14 +669,14 @@ std::unique_ptr<Statement> Parser::parseForStatement() {
       auto expr = parseExpression();
       consume(TokenType::SEMICOLON, "Expected ';' after for loop initializer");
       SourceLocation loc = currentLocation();
-      initializer = std::make_unique<ExpressionStmt>(std::move(expr), loc);
+      initializer = arena_.create<ExpressionStmt>(std::move(expr), loc);
     }
   } else {
     consume(TokenType::SEMICOLON, "Expected ';'");
   }
 
   // Parse condition (optional)
-  std::unique_ptr<Expression> condition = nullptr;
+  Expression *condition = nullptr;
 
   if (!check(TokenType::SEMICOLON)) {
     condition = parseExpression();
@@ -684,7 +684,7 @@ std::unique_ptr<Statement> Parser::parseForStatement() {
   consume(TokenType::SEMICOLON, "Expected ';' after for loop condition");
 
   // Parse increment/update (optional)
-  std::unique_ptr<Expression> increment = nullptr;
+  Expression *increment = nullptr;
 
   if (!check(TokenType::RPAREN)) {
     increment = parseExpression();
@@ -696,11 +696,11 @@ std::unique_ptr<Statement> Parser::parseForStatement() {
   auto body = parseStatement();
 
   SourceLocation loc(for_token.filename, for_token.line, for_token.column);
-  return std::make_unique<ForStmt>(std::move(initializer), std::move(condition),
+  return arena_.create<ForStmt>(std::move(initializer), std::move(condition),
                                    std::move(increment), std::move(body), loc);
 }
 
-std::unique_ptr<Statement> Parser::parseReturnStatement() {
+Statement *Parser::parseReturnStatement() {
   // USER STORY #13: Parse return statements
   // Syntax: return;              (void return)
   //     or: return expression;   (return with value)
@@ -708,7 +708,7 @@ std::unique_ptr<Statement> Parser::parseReturnStatement() {
   Token return_token = current_token_;
   advance(); // consume 'return'
 
-  std::unique_ptr<Expression> returnValue = nullptr;
+  Expression *returnValue = nullptr;
 
   // Check if there's a return value (not just "return;")
   if (!check(TokenType::SEMICOLON)) {
@@ -719,24 +719,24 @@ std::unique_ptr<Statement> Parser::parseReturnStatement() {
 
   SourceLocation loc(return_token.filename, return_token.line,
                      return_token.column);
-  return std::make_unique<ReturnStmt>(std::move(returnValue), loc);
+  return arena_.create<ReturnStmt>(std::move(returnValue), loc);
 }
 
-std::unique_ptr<Statement> Parser::parseExpressionStatement() {
+Statement *Parser::parseExpressionStatement() {
   Token start_token = current_token_;
   auto expr = parseExpression();
   consume(TokenType::SEMICOLON, "Expected ';' after expression");
 
   SourceLocation loc(start_token.filename, start_token.line,
                      start_token.column);
-  return std::make_unique<ExpressionStmt>(std::move(expr), loc);
+  return arena_.create<ExpressionStmt>(std::move(expr), loc);
 }
 
-std::unique_ptr<Statement> Parser::parseCompoundStatement() {
+Statement *Parser::parseCompoundStatement() {
   Token lbrace_token = current_token_;
   consume(TokenType::LBRACE, "Expected '{'");
 
-  std::vector<std::unique_ptr<Statement>> statements;
+  std::vector<Statement *> statements;
 
   while (!check(TokenType::RBRACE) && !check(TokenType::EOF_TOKEN)) {
     // Handle declarations (int x = 5;) or statements
@@ -746,7 +746,7 @@ std::unique_ptr<Statement> Parser::parseCompoundStatement() {
       auto decl = parseVariableDeclaration();
       SourceLocation loc(decl_token.filename, decl_token.line,
                          decl_token.column);
-      statements.push_back(std::make_unique<DeclStmt>(std::move(decl), loc));
+      statements.push_back(arena_.create<DeclStmt>(std::move(decl), loc));
     } else {
       statements.push_back(parseStatement());
     }
@@ -756,15 +756,15 @@ std::unique_ptr<Statement> Parser::parseCompoundStatement() {
 
   SourceLocation loc(lbrace_token.filename, lbrace_token.line,
                      lbrace_token.column);
-  return std::make_unique<CompoundStmt>(std::move(statements), loc);
+  return arena_.create<CompoundStmt>(arena_.makeSpan(statements), loc);
 }
 
 // ============================================================================
 // Program Parsing (Top-Level Entry Point)
 // ============================================================================
 
-std::vector<std::unique_ptr<Declaration>> Parser::parseProgram() {
-  std::vector<std::unique_ptr<Declaration>> declarations;
+std::vector<Declaration *> Parser::parseProgram() {
+  std::vector<Declaration *> declarations;
 
   // Parse all top-level declarations until we reach EOF
   while (!check(TokenType::EOF_TOKEN)) {
@@ -797,7 +797,7 @@ std::vector<std::unique_ptr<Declaration>> Parser::parseProgram() {
 // Declaration Parsing
 // ============================================================================
 
-std::unique_ptr<Declaration> Parser::parseDeclaration() {
+Declaration *Parser::parseDeclaration() {
   // USER STORY #19: Check for struct definition vs struct variable declaration
   if (check(TokenType::KW_STRUCT)) {
     return parseStructDeclarationOrDefinition();
@@ -850,8 +850,8 @@ std::unique_ptr<Declaration> Parser::parseDeclaration() {
 // ============================================================================
 
 // Helper: Parse struct field list { type name; type name; ... }
-std::vector<std::unique_ptr<VarDecl>> Parser::parseStructFieldList() {
-  std::vector<std::unique_ptr<VarDecl>> fields;
+std::vector<VarDecl *> Parser::parseStructFieldList() {
+  std::vector<VarDecl *> fields;
 
   while (!check(TokenType::RBRACE) &&
          current_token_.type != TokenType::EOF_TOKEN) {
@@ -886,7 +886,7 @@ std::vector<std::unique_ptr<VarDecl>> Parser::parseStructFieldList() {
 
     // Handle array fields [size]
     bool isArray = false;
-    std::unique_ptr<Expression> arraySize = nullptr;
+    Expression *arraySize = nullptr;
 
     if (check(TokenType::LBRACKET)) {
       advance(); // consume '['
@@ -904,7 +904,7 @@ std::vector<std::unique_ptr<VarDecl>> Parser::parseStructFieldList() {
     SourceLocation fieldLoc(field_start.filename, field_start.line,
                             field_start.column);
     fields.push_back(
-        std::make_unique<VarDecl>(fieldName, fieldType, nullptr, fieldLoc,
+        arena_.create<VarDecl>(fieldName, fieldType, nullptr, fieldLoc,
                                   isArray, std::move(arraySize), pointerLevel));
   }
 
@@ -913,7 +913,7 @@ std::vector<std::unique_ptr<VarDecl>> Parser::parseStructFieldList() {
 
 // Helper: Parse struct declaration or definition
 // Handles: struct Point { ... };  OR  struct Point p;
-std::unique_ptr<Declaration> Parser::parseStructDeclarationOrDefinition() {
+Declaration *Parser::parseStructDeclarationOrDefinition() {
   Token structToken = current_token_;
   advance(); // consume 'struct'
 
@@ -932,15 +932,15 @@ std::unique_ptr<Declaration> Parser::parseStructDeclarationOrDefinition() {
     consume(TokenType::LBRACE, "Expected '{' after struct name");
 
     // Parse member fields
-    std::vector<std::unique_ptr<VarDecl>> fields = parseStructFieldList();
+    std::vector<VarDecl *> fields = parseStructFieldList();
 
     consume(TokenType::RBRACE, "Expected '}' after struct fields");
     consume(TokenType::SEMICOLON, "Expected ';' after struct definition");
 
     SourceLocation loc(structToken.filename, structToken.line,
                        structToken.column);
-    return std::make_unique<StructDecl>(std::string(nameToken.value),
-                                        std::move(fields), loc);
+    return arena_.create<StructDecl>(std::string(nameToken.value),
+                                     arena_.makeSpan(fields), loc);
   } else {
     // It's a variable declaration with struct type: struct Point p;
     std::string type =
@@ -966,7 +966,7 @@ std::unique_ptr<Declaration> Parser::parseStructDeclarationOrDefinition() {
 
     // Handle array declaration
     bool isArray = false;
-    std::unique_ptr<Expression> arraySize = nullptr;
+    Expression *arraySize = nullptr;
 
     if (check(TokenType::LBRACKET)) {
       advance();
@@ -980,7 +980,7 @@ std::unique_ptr<Declaration> Parser::parseStructDeclarationOrDefinition() {
     }
 
     // Handle initialization
-    std::unique_ptr<Expression> initializer = nullptr;
+    Expression *initializer = nullptr;
     if (match(TokenType::OP_ASSIGN)) {
       initializer = parseExpression();
     }
@@ -989,7 +989,7 @@ std::unique_ptr<Declaration> Parser::parseStructDeclarationOrDefinition() {
 
     SourceLocation loc(structToken.filename, structToken.line,
                        structToken.column);
-    return std::make_unique<VarDecl>(var_name, type, std::move(initializer),
+    return arena_.create<VarDecl>(var_name, type, std::move(initializer),
                                      loc, isArray, std::move(arraySize),
                                      pointerLevel);
   }
@@ -997,7 +997,7 @@ std::unique_ptr<Declaration> Parser::parseStructDeclarationOrDefinition() {
 
 // Helper: Parse function declaration/definition
 // Handles: int foo(int x) { ... }  OR  int foo(int x);
-std::unique_ptr<Declaration> Parser::parseFunctionDeclarationImpl(
+Declaration *Parser::parseFunctionDeclarationImpl(
     const Token &start_token, const std::string &type, const std::string &name,
     int pointerLevel, bool isExtern) {
   // Append pointers to type string
@@ -1007,16 +1007,15 @@ std::unique_ptr<Declaration> Parser::parseFunctionDeclarationImpl(
   }
   // Parse parameter list
   consume(TokenType::LPAREN, "Expected '(' after function name");
-  std::vector<std::unique_ptr<ParameterDecl>> parameters = parseParameterList();
+  std::vector<ParameterDecl *> parameters = parseParameterList();
   consume(TokenType::RPAREN, "Expected ')' after parameter list");
 
   // Check if this is a forward declaration (;) or a definition ({...})
-  std::unique_ptr<CompoundStmt> body = nullptr;
+  CompoundStmt *body = nullptr;
 
   if (check(TokenType::LBRACE)) {
     // Function definition with body
-    body = std::unique_ptr<CompoundStmt>(
-        dynamic_cast<CompoundStmt *>(parseCompoundStatement().release()));
+    body = dynamic_cast<CompoundStmt *>(parseCompoundStatement());
   } else if (match(TokenType::SEMICOLON)) {
     // Forward declaration - body remains nullptr
   } else {
@@ -1027,24 +1026,24 @@ std::unique_ptr<Declaration> Parser::parseFunctionDeclarationImpl(
 
   SourceLocation loc(start_token.filename, start_token.line,
                      start_token.column);
-  return std::make_unique<FunctionDecl>(name, type, std::move(parameters),
-                                        std::move(body), loc, isExtern);
+  return arena_.create<FunctionDecl>(name, type, arena_.makeSpan(parameters),
+                                     body, loc, isExtern);
 }
 
 // Helper: Parse array declaration
 // Handles: int arr[10];  OR  int arr[10] = ...;
-std::unique_ptr<Declaration>
+Declaration *
 Parser::parseArrayDeclaration(const Token &start_token, const std::string &type,
                               const std::string &name, int pointerLevel) {
   consume(TokenType::LBRACKET, "Expected '['");
 
   // Parse array size expression
-  std::unique_ptr<Expression> arraySize = parseExpression();
+  Expression *arraySize = parseExpression();
 
   consume(TokenType::RBRACKET, "Expected ']' after array size");
 
   // Arrays can optionally have initializers
-  std::unique_ptr<Expression> initializer = nullptr;
+  Expression *initializer = nullptr;
   if (match(TokenType::OP_ASSIGN)) {
     initializer = parseExpression();
   }
@@ -1058,17 +1057,17 @@ Parser::parseArrayDeclaration(const Token &start_token, const std::string &type,
 
   SourceLocation loc(start_token.filename, start_token.line,
                      start_token.column);
-  return std::make_unique<VarDecl>(name, type, std::move(initializer), loc,
+  return arena_.create<VarDecl>(name, type, std::move(initializer), loc,
                                    true, std::move(arraySize), pointerLevel);
 }
 
 // Helper: Parse regular variable declaration
 // Handles: int x;  OR  int x = 5;  OR  int *p = &x;
-std::unique_ptr<Declaration> Parser::parseVariableDeclarationImpl(
+Declaration *Parser::parseVariableDeclarationImpl(
     const Token &start_token, const std::string &type, const std::string &name,
     int pointerLevel) {
   // Handle initialization
-  std::unique_ptr<Expression> initializer = nullptr;
+  Expression *initializer = nullptr;
 
   if (match(TokenType::OP_ASSIGN)) {
     initializer = parseExpression();
@@ -1083,13 +1082,13 @@ std::unique_ptr<Declaration> Parser::parseVariableDeclarationImpl(
 
   SourceLocation loc(start_token.filename, start_token.line,
                      start_token.column);
-  return std::make_unique<VarDecl>(name, type, std::move(initializer), loc,
+  return arena_.create<VarDecl>(name, type, std::move(initializer), loc,
                                    false, nullptr, pointerLevel);
 }
 
 // USER STORY #19: Parse Struct Definitions
 // Syntax: struct Name { type1 field1; type2 field2; ... };
-std::unique_ptr<Declaration> Parser::parseStructDefinition() {
+Declaration *Parser::parseStructDefinition() {
   Token start_token = current_token_;
   consume(TokenType::KW_STRUCT, "Expected 'struct' keyword");
 
@@ -1099,7 +1098,7 @@ std::unique_ptr<Declaration> Parser::parseStructDefinition() {
   consume(TokenType::LBRACE, "Expected '{' after struct name");
 
   // Parse member fields (zero or more variable declarations)
-  std::vector<std::unique_ptr<VarDecl>> fields;
+  std::vector<VarDecl *> fields;
 
   while (!check(TokenType::RBRACE) &&
          current_token_.type != TokenType::EOF_TOKEN) {
@@ -1135,7 +1134,7 @@ std::unique_ptr<Declaration> Parser::parseStructDefinition() {
 
     // Handle array fields
     bool isArray = false;
-    std::unique_ptr<Expression> arraySize = nullptr;
+    Expression *arraySize = nullptr;
 
     if (check(TokenType::LBRACKET)) {
       advance(); // consume '['
@@ -1153,7 +1152,7 @@ std::unique_ptr<Declaration> Parser::parseStructDefinition() {
     SourceLocation fieldLoc(field_start.filename, field_start.line,
                             field_start.column);
     fields.push_back(
-        std::make_unique<VarDecl>(fieldName, fieldType, nullptr, fieldLoc,
+        arena_.create<VarDecl>(fieldName, fieldType, nullptr, fieldLoc,
                                   isArray, std::move(arraySize), pointerLevel));
   }
 
@@ -1162,17 +1161,17 @@ std::unique_ptr<Declaration> Parser::parseStructDefinition() {
 
   SourceLocation loc(start_token.filename, start_token.line,
                      start_token.column);
-  return std::make_unique<StructDecl>(structName, std::move(fields), loc);
+  return arena_.create<StructDecl>(structName, arena_.makeSpan(fields), loc);
 }
 
-std::unique_ptr<Declaration> Parser::parseVariableDeclaration() {
+Declaration *Parser::parseVariableDeclaration() {
   // This method is kept for backward compatibility but just calls
   // parseDeclaration() The main logic is now in parseDeclaration() which
   // handles both variables and functions
   return parseDeclaration();
 }
 
-std::unique_ptr<Declaration> Parser::parseFunctionDeclaration() {
+Declaration *Parser::parseFunctionDeclaration() {
   // This method is kept for potential future use but just calls
   // parseDeclaration() The main logic is now in parseDeclaration() which
   // handles both variables and functions
@@ -1221,12 +1220,12 @@ std::string Parser::parseType() {
   return type;
 }
 
-std::vector<std::unique_ptr<ParameterDecl>> Parser::parseParameterList() {
+std::vector<ParameterDecl *> Parser::parseParameterList() {
   // USER STORY #12: Parse function parameter list
   // Syntax: (type name, type name, ...)
   // Empty parameter list: () or (void)
 
-  std::vector<std::unique_ptr<ParameterDecl>> parameters;
+  std::vector<ParameterDecl *> parameters;
 
   // Handle empty parameter list or (void)
   if (check(TokenType::RPAREN)) {
@@ -1267,7 +1266,7 @@ std::vector<std::unique_ptr<ParameterDecl>> Parser::parseParameterList() {
     SourceLocation loc(param_start.filename, param_start.line,
                        param_start.column);
     parameters.push_back(
-        std::make_unique<ParameterDecl>(paramName, paramType, loc));
+        arena_.create<ParameterDecl>(paramName, paramType, loc));
 
     // Check for comma (more parameters)
     if (!check(TokenType::COMMA)) {
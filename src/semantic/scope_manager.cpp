@@ -1,26 +1,97 @@
 #include "../../include/scope_manager.h"
 
+namespace {
+    // Initial open-addressing index size; must stay a power of two so the
+    // probe mask is a single AND.
+    constexpr size_t kInitialSlotCount = 64;
+
+    // Fibonacci-style integer hash spreads dense IDs across the table.
+    inline size_t hash_id(uint32_t id) {
+        return static_cast<size_t>(id) * 2654435761u;
+    }
+}
+
 // Constructor - automatically creates global scope
 ScopeManager::ScopeManager() : current_scope_level_(0) {
-    // Initialize with global scope (scope level 0)
-    scope_stack_.push_back(SymbolTable());
+    slots_.assign(kInitialSlotCount, 0);
+    scope_marks_.push_back(0);  // Global scope watermark
+}
+
+// ============================================================================
+// Interning and probing internals
+// ============================================================================
+
+uint32_t ScopeManager::intern_name(const std::string& name) {
+    auto it = name_ids_.find(name);
+    if (it != name_ids_.end()) {
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(id_names_.size());
+    auto inserted = name_ids_.emplace(name, id);
+    id_names_.push_back(&inserted.first->first);
+    return id;
+}
+
+uint32_t ScopeManager::find_name_id(const std::string& name) const {
+    auto it = name_ids_.find(name);
+    return (it != name_ids_.end()) ? it->second : UINT32_MAX;
+}
+
+// Find the slot for name_id: either the slot currently indexing one of its
+// bindings, or the first empty slot where it would go.
+size_t ScopeManager::probe_slot(uint32_t name_id) const {
+    size_t mask = slots_.size() - 1;
+    size_t slot = hash_id(name_id) & mask;
+    while (slots_[slot] != 0 && store_[slots_[slot] - 1].name_id != name_id) {
+        slot = (slot + 1) & mask;  // Linear probe
+    }
+    return slot;
+}
+
+void ScopeManager::grow_slots() {
+    slots_.assign(slots_.size() * 2, 0);
+    // Reindex every binding oldest-first so each name's slot ends up
+    // pointing at its newest binding and shadow links stay correct.
+    for (size_t i = 0; i < store_.size(); ++i) {
+        size_t slot = probe_slot(store_[i].name_id);
+        store_[i].prev_binding = slots_[slot];
+        slots_[slot] = static_cast<uint32_t>(i + 1);
+    }
+}
+
+uint32_t ScopeManager::newest_binding(const std::string& name) const {
+    uint32_t name_id = find_name_id(name);
+    if (name_id == UINT32_MAX) {
+        return 0;
+    }
+    return slots_[probe_slot(name_id)];
 }
 
-// Enter a new scope (push a new symbol table onto the stack)
+// ============================================================================
+// Scope operations
+// ============================================================================
+
+// Enter a new scope: just remember where the store currently ends
 void ScopeManager::enter_scope() {
     current_scope_level_++;
-    scope_stack_.push_back(SymbolTable());
+    scope_marks_.push_back(store_.size());
 }
 
-// Exit the current scope (pop the top symbol table)
-// Returns false if attempting to pop global scope, true otherwise
+// Exit the current scope: unwind bindings back to the watermark,
+// restoring each name's shadowed binding in the index
 bool ScopeManager::exit_scope() {
     // Protect global scope - cannot pop it
-    if (current_scope_level_ == 0 || scope_stack_.size() <= 1) {
+    if (current_scope_level_ == 0 || scope_marks_.size() <= 1) {
         return false;
     }
 
-    scope_stack_.pop_back();
+    size_t mark = scope_marks_.back();
+    scope_marks_.pop_back();
+    while (store_.size() > mark) {
+        const StoredSymbol& entry = store_.back();
+        slots_[probe_slot(entry.name_id)] = entry.prev_binding;
+        store_.pop_back();
+    }
     current_scope_level_--;
     return true;
 }
@@ -28,98 +99,100 @@ bool ScopeManager::exit_scope() {
 // Insert a symbol into the current (innermost) scope
 // Returns true if inserted, false if symbol already exists in current scope
 bool ScopeManager::insert(const Symbol& symbol) {
-    if (scope_stack_.empty()) {
-        return false;
+    // Keep the index at most half full so probe chains stay short
+    if ((store_.size() + 1) * 2 > slots_.size()) {
+        grow_slots();
     }
 
-    // Create a new symbol with the current scope level
-    Symbol scoped_symbol = symbol;
-    scoped_symbol.scope_level = current_scope_level_;
+    uint32_t name_id = intern_name(symbol.name);
+    size_t slot = probe_slot(name_id);
+    uint32_t existing = slots_[slot];
 
-    // Insert into the current (top) scope
-    return scope_stack_.back().insert(scoped_symbol);
+    // Redeclaration check: newest binding in the current scope?
+    if (existing != 0 &&
+        existing > scope_marks_.back()) {
+        return false;  // Symbol already exists in this scope
+    }
+
+    StoredSymbol entry;
+    entry.symbol = symbol;
+    entry.symbol.scope_level = current_scope_level_;
+    entry.name_id = name_id;
+    entry.prev_binding = existing;  // Link to the binding we shadow (if any)
+    store_.push_back(std::move(entry));
+    slots_[slot] = static_cast<uint32_t>(store_.size());
+    return true;
 }
 
-// Lookup a symbol by name, searching from innermost to outermost scope
-// Returns the first matching symbol found, or std::nullopt if not found
+// Lookup a symbol by name; the index always points at the newest (innermost)
+// binding, so shadowing works without walking scopes
 std::optional<Symbol> ScopeManager::lookup(const std::string& name) const {
-    // Search from innermost (top of stack) to outermost (bottom of stack)
-    for (auto it = scope_stack_.rbegin(); it != scope_stack_.rend(); ++it) {
-        auto result = it->lookup(name);
-        if (result.has_value()) {
-            return result;
-        }
+    uint32_t binding = newest_binding(name);
+    if (binding == 0) {
+        return std::nullopt;
     }
-
-    // Not found in any scope
-    return std::nullopt;
+    return store_[binding - 1].symbol;
 }
 
 // Check if a symbol exists in the current scope only
 bool ScopeManager::exists_in_current_scope(const std::string& name) const {
-    if (scope_stack_.empty()) {
-        return false;
-    }
-    return scope_stack_.back().exists(name);
+    uint32_t binding = newest_binding(name);
+    return binding != 0 && binding > scope_marks_.back();
 }
 
 // Check if a symbol exists in any scope (innermost to outermost)
 bool ScopeManager::exists_in_any_scope(const std::string& name) const {
-    return lookup(name).has_value();
+    return newest_binding(name) != 0;
 }
 
 // Clear all scopes and reset to just global scope
 void ScopeManager::reset() {
-    scope_stack_.clear();
+    store_.clear();
+    slots_.assign(kInitialSlotCount, 0);
+    scope_marks_.clear();
+    scope_marks_.push_back(0);
+    name_ids_.clear();
+    id_names_.clear();
     current_scope_level_ = 0;
-    scope_stack_.push_back(SymbolTable());
 }
 
 // Get the number of symbols in the current scope
 size_t ScopeManager::get_current_scope_size() const {
-    if (scope_stack_.empty()) {
-        return 0;
-    }
-    return scope_stack_.back().size();
+    return store_.size() - scope_marks_.back();
 }
 
 // Get the total number of symbols across all scopes
 size_t ScopeManager::get_total_symbol_count() const {
-    size_t total = 0;
-    for (const auto& table : scope_stack_) {
-        total += table.size();
-    }
-    return total;
+    return store_.size();
 }
 
 // Get all symbol names from all scopes
 std::vector<std::string> ScopeManager::get_all_symbol_names() const {
     std::vector<std::string> all_names;
-
-    // Collect names from all scopes (innermost to outermost)
-    for (const auto& table : scope_stack_) {
-        auto names = table.get_all_names();
-        all_names.insert(all_names.end(), names.begin(), names.end());
+    all_names.reserve(store_.size());
+    for (const auto& entry : store_) {
+        all_names.push_back(*id_names_[entry.name_id]);
     }
-
     return all_names;
 }
 
-// Mark a symbol as used (searches all scopes from innermost to outermost)
+// Mark a symbol as used (innermost binding wins, matching lookup)
 void ScopeManager::mark_symbol_as_used(const std::string& name) {
-    // Search from innermost (top of stack) to outermost (bottom of stack)
-    for (auto it = scope_stack_.rbegin(); it != scope_stack_.rend(); ++it) {
-        if (it->exists(name)) {
-            it->mark_as_used(name);
-            return;  // Found and marked, done
-        }
+    uint32_t binding = newest_binding(name);
+    if (binding != 0) {
+        store_[binding - 1].symbol.used = true;
     }
 }
 
 // Get all unused variables from the current scope
 std::vector<Symbol> ScopeManager::get_unused_variables_in_current_scope() const {
-    if (scope_stack_.empty()) {
-        return std::vector<Symbol>();
+    std::vector<Symbol> unused;
+    for (size_t i = scope_marks_.back(); i < store_.size(); ++i) {
+        const Symbol& sym = store_[i].symbol;
+        // Only report unused variables (not functions)
+        if (!sym.is_function && !sym.used) {
+            unused.push_back(sym);
+        }
     }
-    return scope_stack_.back().get_unused_variables();
+    return unused;
 }
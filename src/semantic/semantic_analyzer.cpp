@@ -6,7 +6,7 @@
 // ============================================================================
 
 SemanticAnalyzer::SemanticAnalyzer()
-    : in_function_scope_(false), warnings_enabled_(true) {}
+    : arena_(nullptr), in_function_scope_(false), warnings_enabled_(true) {}
 
 void SemanticAnalyzer::add_error(const std::string &message,
                                  const SourceLocation &location) {
@@ -39,7 +39,7 @@ bool SemanticAnalyzer::register_symbol(const Symbol &symbol,
 }
 
 void SemanticAnalyzer::analyze_program(
-    const std::vector<std::unique_ptr<Declaration>> &declarations) {
+    const std::vector<Declaration *> &declarations) {
   // Clear any previous errors, warnings, and expression types
   error_handler_.clear();
   expression_types_.clear();
@@ -759,22 +759,22 @@ void SemanticAnalyzer::visit(BinaryExpr &node) {
 
   // If array decay occurred, insert implicit conversion nodes
   if (!left_type->equals(*left_type_decayed)) {
-    auto cast_node = std::make_unique<TypeCastExpr>(
+    auto *cast_node = arena_->create<TypeCastExpr>(
         node.releaseLeft(), left_type_decayed->toString(),
         true, // implicit conversion
         node.getLocation());
-    set_expression_type(cast_node.get(), left_type_decayed);
-    node.setLeft(std::move(cast_node));
+    set_expression_type(cast_node, left_type_decayed);
+    node.setLeft(cast_node);
     left_type = left_type_decayed;
   }
 
   if (!right_type->equals(*right_type_decayed)) {
-    auto cast_node = std::make_unique<TypeCastExpr>(
+    auto *cast_node = arena_->create<TypeCastExpr>(
         node.releaseRight(), right_type_decayed->toString(),
         true, // implicit conversion
         node.getLocation());
-    set_expression_type(cast_node.get(), right_type_decayed);
-    node.setRight(std::move(cast_node));
+    set_expression_type(cast_node, right_type_decayed);
+    node.setRight(cast_node);
     right_type = right_type_decayed;
   }
 
@@ -859,21 +859,21 @@ void SemanticAnalyzer::visit(BinaryExpr &node) {
     if (common_type) {
       // Insert conversion nodes if types don't match the common type
       if (!left_type->equals(*common_type)) {
-        auto cast_node = std::make_unique<TypeCastExpr>(
+        auto *cast_node = arena_->create<TypeCastExpr>(
             node.releaseLeft(), common_type->toString(),
             true, // implicit conversion
             node.getLocation());
-        set_expression_type(cast_node.get(), common_type);
-        node.setLeft(std::move(cast_node));
+        set_expression_type(cast_node, common_type);
+        node.setLeft(cast_node);
       }
 
       if (!right_type->equals(*common_type)) {
-        auto cast_node = std::make_unique<TypeCastExpr>(
+        auto *cast_node = arena_->create<TypeCastExpr>(
             node.releaseRight(), common_type->toString(),
             true, // implicit conversion
             node.getLocation());
-        set_expression_type(cast_node.get(), common_type);
-        node.setRight(std::move(cast_node));
+        set_expression_type(cast_node, common_type);
+        node.setRight(cast_node);
       }
     }
 
@@ -888,19 +888,19 @@ void SemanticAnalyzer::visit(BinaryExpr &node) {
 
       if (common_type) {
         if (!left_type->equals(*common_type)) {
-          auto cast_node = std::make_unique<TypeCastExpr>(
+          auto *cast_node = arena_->create<TypeCastExpr>(
               node.releaseLeft(), common_type->toString(), true,
               node.getLocation());
-          set_expression_type(cast_node.get(), common_type);
-          node.setLeft(std::move(cast_node));
+          set_expression_type(cast_node, common_type);
+          node.setLeft(cast_node);
         }
 
         if (!right_type->equals(*common_type)) {
-          auto cast_node = std::make_unique<TypeCastExpr>(
+          auto *cast_node = arena_->create<TypeCastExpr>(
               node.releaseRight(), common_type->toString(), true,
               node.getLocation());
-          set_expression_type(cast_node.get(), common_type);
-          node.setRight(std::move(cast_node));
+          set_expression_type(cast_node, common_type);
+          node.setRight(cast_node);
         }
       }
     }
@@ -918,19 +918,19 @@ void SemanticAnalyzer::visit(BinaryExpr &node) {
     auto right_promoted = apply_integer_promotion(right_type);
 
     if (!left_type->equals(*left_promoted)) {
-      auto cast_node = std::make_unique<TypeCastExpr>(node.releaseLeft(),
+      auto *cast_node = arena_->create<TypeCastExpr>(node.releaseLeft(),
                                                       left_promoted->toString(),
                                                       true, node.getLocation());
-      set_expression_type(cast_node.get(), left_promoted);
-      node.setLeft(std::move(cast_node));
+      set_expression_type(cast_node, left_promoted);
+      node.setLeft(cast_node);
     }
 
     if (!right_type->equals(*right_promoted)) {
-      auto cast_node = std::make_unique<TypeCastExpr>(
+      auto *cast_node = arena_->create<TypeCastExpr>(
           node.releaseRight(), right_promoted->toString(), true,
           node.getLocation());
-      set_expression_type(cast_node.get(), right_promoted);
-      node.setRight(std::move(cast_node));
+      set_expression_type(cast_node, right_promoted);
+      node.setRight(cast_node);
     }
 
     result_type = getArithmeticResultType(*left_type, *right_type, op);
@@ -1193,7 +1193,7 @@ void SemanticAnalyzer::visit(CallExpr &node) {
   // Check argument types
   for (size_t i = 0; i < expected_params.size(); ++i) {
     auto expected_type = expected_params[i];
-    auto actual_type = get_expression_type(actual_args[i].get());
+    auto actual_type = get_expression_type(actual_args[i]);
 
     if (!expected_type || !actual_type) {
       continue; // Can't check if type info is missing
@@ -31,40 +31,79 @@ Type::Type(const std::string &struct_name,
 // Static Factory Methods
 // ========================================
 
+// ============================================================================
+// TypeContext Implementation
+// ============================================================================
+
+TypeContext &TypeContext::instance() {
+  static TypeContext context;
+  return context;
+}
+
+std::shared_ptr<Type> TypeContext::get(int base, int pointer_depth,
+                                       bool is_array, int array_size) {
+  // Pack the shape into one key: base (8 bits), depth (16), array flag
+  // (1), size (32). Collisions are impossible within sane limits.
+  uint64_t key = (static_cast<uint64_t>(base) & 0xFF) |
+                 ((static_cast<uint64_t>(pointer_depth) & 0xFFFF) << 8) |
+                 (static_cast<uint64_t>(is_array ? 1 : 0) << 24) |
+                 (static_cast<uint64_t>(static_cast<uint32_t>(array_size)) << 25);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = types_.find(key);
+  if (it != types_.end()) {
+    return it->second;
+  }
+
+  std::shared_ptr<Type> type;
+  Type::BaseType baseType = static_cast<Type::BaseType>(base);
+  if (is_array && pointer_depth > 0) {
+    type = std::make_shared<Type>(baseType, pointer_depth, array_size);
+  } else if (is_array) {
+    type = std::make_shared<Type>(baseType, array_size, true);
+  } else if (pointer_depth > 0) {
+    type = std::make_shared<Type>(baseType, pointer_depth);
+  } else {
+    type = std::make_shared<Type>(baseType);
+  }
+  types_.emplace(key, type);
+  return type;
+}
+
 std::shared_ptr<Type> Type::makeInt() {
-  return std::make_shared<Type>(BaseType::INT);
+  return TypeContext::instance().get(static_cast<int>(BaseType::INT));
 }
 
 std::shared_ptr<Type> Type::makeFloat() {
-  return std::make_shared<Type>(BaseType::FLOAT);
+  return TypeContext::instance().get(static_cast<int>(BaseType::FLOAT));
 }
 
 std::shared_ptr<Type> Type::makeChar() {
-  return std::make_shared<Type>(BaseType::CHAR);
+  return TypeContext::instance().get(static_cast<int>(BaseType::CHAR));
 }
 
 std::shared_ptr<Type> Type::makeVoid() {
-  return std::make_shared<Type>(BaseType::VOID);
+  return TypeContext::instance().get(static_cast<int>(BaseType::VOID));
 }
 
 std::shared_ptr<Type> Type::makeDouble() {
-  return std::make_shared<Type>(BaseType::DOUBLE);
+  return TypeContext::instance().get(static_cast<int>(BaseType::DOUBLE));
 }
 
 std::shared_ptr<Type> Type::makeLong() {
-  return std::make_shared<Type>(BaseType::LONG);
+  return TypeContext::instance().get(static_cast<int>(BaseType::LONG));
 }
 
 std::shared_ptr<Type> Type::makeShort() {
-  return std::make_shared<Type>(BaseType::SHORT);
+  return TypeContext::instance().get(static_cast<int>(BaseType::SHORT));
 }
 
 std::shared_ptr<Type> Type::makePointer(BaseType base, int depth) {
-  return std::make_shared<Type>(base, depth);
+  return TypeContext::instance().get(static_cast<int>(base), depth);
 }
 
 std::shared_ptr<Type> Type::makeArray(BaseType base, int size) {
-  return std::make_shared<Type>(base, size, true);
+  return TypeContext::instance().get(static_cast<int>(base), 0, true, size);
 }
 
 std::shared_ptr<Type>
@@ -117,7 +156,7 @@ std::shared_ptr<Type> Type::fromString(const std::string &type_str) {
   if (pointer_depth > 0) {
     return makePointer(base, pointer_depth);
   }
-  return std::make_shared<Type>(base);
+  return TypeContext::instance().get(static_cast<int>(base));
 }
 
 // ========================================
@@ -154,6 +193,11 @@ bool Type::isFloatingPoint() const {
 // ========================================
 
 bool Type::equals(const Type &other) const {
+  // Interned types: the same canonical object is trivially equal
+  if (this == &other) {
+    return true;
+  }
+
   // Base type must match
   if (base_type_ != other.base_type_) {
     return false;
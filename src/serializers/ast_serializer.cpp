@@ -1,322 +1,283 @@
 #include "json_serializers.h"
-#include "third_party/json.hpp"
-#include <sstream>
-#include <stack>
 
-using json = nlohmann::json;
+#include <cstdio>
+#include <string>
+#include <vector>
 
 // ============================================================================
-// JsonSerializerVisitor - Visitor class for AST to JSON serialization
+// Streaming AST JSON serialization
 // ============================================================================
+// The serializer walks the AST once and writes JSON text straight into a
+// growing buffer — no intermediate nlohmann DOM, which used to allocate
+// far more than the AST itself on large inputs. Output is byte-compatible
+// with the old DOM path: 2-space pretty printing and alphabetically
+// ordered keys (nlohmann's map ordering), so the frontend and any stored
+// dumps see the exact same bytes.
 
-class JsonSerializerVisitor : public ASTVisitor {
-private:
-  std::stack<json> nodeStack; // Stack to build JSON tree recursively
+namespace {
+
+// Minimal pretty-printing JSON writer matching nlohmann::json::dump(2).
+class StreamingJsonWriter {
+public:
+  explicit StreamingJsonWriter(std::string &out) : out_(out) {}
 
-  // Helper: Add location info to a JSON object
-  void addLocation(json &j, const ASTNode &node) {
-    j["location"] = {{"file", node.getLocation().filename},
-                     {"line", node.getLine()},
-                     {"column", node.getColumn()}};
+  void beginObject() {
+    prefixValue();
+    out_ += '{';
+    stack_.push_back({true, true});
+  }
+  void endObject() {
+    bool wasEmpty = stack_.back().empty;
+    stack_.pop_back();
+    if (wasEmpty) {
+      out_ += '}';
+    } else {
+      out_ += '\n';
+      writeIndent();
+      out_ += '}';
+    }
+  }
+  void beginArray() {
+    prefixValue();
+    out_ += '[';
+    stack_.push_back({true, false});
+  }
+  void endArray() {
+    bool wasEmpty = stack_.back().empty;
+    stack_.pop_back();
+    if (wasEmpty) {
+      out_ += ']';
+    } else {
+      out_ += '\n';
+      writeIndent();
+      out_ += ']';
+    }
   }
 
-  // Helper: Convert ASTNodeType enum to string
-  std::string nodeTypeToString(ASTNodeType type) {
-    switch (type) {
-    // Expression types
-    case ASTNodeType::BINARY_EXPR:
-      return "BINARY_EXPR";
-    case ASTNodeType::UNARY_EXPR:
-      return "UNARY_EXPR";
-    case ASTNodeType::LITERAL_EXPR:
-      return "LITERAL_EXPR";
-    case ASTNodeType::IDENTIFIER_EXPR:
-      return "IDENTIFIER_EXPR";
-    case ASTNodeType::CALL_EXPR:
-      return "CALL_EXPR";
-    case ASTNodeType::ASSIGNMENT_EXPR:
-      return "ASSIGNMENT_EXPR";
-    case ASTNodeType::ARRAY_ACCESS_EXPR:
-      return "ARRAY_ACCESS_EXPR";
-    case ASTNodeType::MEMBER_ACCESS_EXPR:
-      return "MEMBER_ACCESS_EXPR";
-    case ASTNodeType::TYPE_CAST_EXPR:
-      return "TYPE_CAST_EXPR";
-    case ASTNodeType::SIZEOF_EXPR:
-      return "SIZEOF_EXPR";
-    case ASTNodeType::TERNARY_EXPR:
-      return "TERNARY_EXPR";
-
-    // Statement types
-    case ASTNodeType::IF_STMT:
-      return "IF_STMT";
-    case ASTNodeType::WHILE_STMT:
-      return "WHILE_STMT";
-    case ASTNodeType::FOR_STMT:
-      return "FOR_STMT";
-    case ASTNodeType::RETURN_STMT:
-      return "RETURN_STMT";
-    case ASTNodeType::COMPOUND_STMT:
-      return "COMPOUND_STMT";
-    case ASTNodeType::EXPRESSION_STMT:
-      return "EXPRESSION_STMT";
-
-    // Declaration types
-    case ASTNodeType::VAR_DECL:
-      return "VAR_DECL";
-    case ASTNodeType::TYPE_DECL:
-      return "TYPE_DECL";
-    case ASTNodeType::STRUCT_DECL:
-      return "STRUCT_DECL";
-    case ASTNodeType::FUNCTION_DECL:
-      return "FUNCTION_DECL";
-    case ASTNodeType::PARAMETER_DECL:
-      return "PARAMETER_DECL";
+  void key(const char *name) {
+    nextEntry();
+    out_ += '"';
+    out_ += name;
+    out_ += "\": ";
+    pendingValue_ = true;
+  }
 
-    default:
-      return "UNKNOWN";
+  void writeString(const std::string &value) {
+    prefixValue();
+    out_ += '"';
+    escapeInto(value);
+    out_ += '"';
+  }
+  void writeBool(bool value) {
+    prefixValue();
+    out_ += value ? "true" : "false";
+  }
+  void writeInt(long long value) {
+    prefixValue();
+    out_ += std::to_string(value);
+  }
+  void writeUInt(unsigned long long value) {
+    prefixValue();
+    out_ += std::to_string(value);
+  }
+  void writeNull() {
+    prefixValue();
+    out_ += "null";
+  }
+
+private:
+  struct Level {
+    bool empty;
+    bool isObject;
+  };
+
+  // Called before every value; array elements get their own line, while
+  // object values follow their key on the same line.
+  void prefixValue() {
+    if (pendingValue_) {
+      pendingValue_ = false;
+      return;
+    }
+    if (!stack_.empty() && !stack_.back().isObject) {
+      nextEntry();
     }
   }
 
-  // Helper: Convert LiteralType enum to string
-  std::string literalTypeToString(LiteralExpr::LiteralType type) {
-    switch (type) {
-    case LiteralExpr::LiteralType::INTEGER:
-      return "INTEGER";
-    case LiteralExpr::LiteralType::FLOAT:
-      return "FLOAT";
-    case LiteralExpr::LiteralType::STRING:
-      return "STRING";
-    case LiteralExpr::LiteralType::CHAR:
-      return "CHAR";
-    case LiteralExpr::LiteralType::BOOLEAN:
-      return "BOOLEAN";
-    default:
-      return "UNKNOWN";
+  void nextEntry() {
+    if (!stack_.back().empty) {
+      out_ += ',';
     }
+    stack_.back().empty = false;
+    out_ += '\n';
+    writeIndent();
   }
 
-public:
-  // Get the final result from the stack
-  json getResult() {
-    if (nodeStack.empty()) {
-      return json::object();
+  void writeIndent() { out_.append(stack_.size() * 2, ' '); }
+
+  void escapeInto(const std::string &value) {
+    for (unsigned char c : value) {
+      switch (c) {
+      case '"':
+        out_ += "\\\"";
+        break;
+      case '\\':
+        out_ += "\\\\";
+        break;
+      case '\b':
+        out_ += "\\b";
+        break;
+      case '\f':
+        out_ += "\\f";
+        break;
+      case '\n':
+        out_ += "\\n";
+        break;
+      case '\r':
+        out_ += "\\r";
+        break;
+      case '\t':
+        out_ += "\\t";
+        break;
+      default:
+        if (c < 0x20) {
+          char buffer[8];
+          std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+          out_ += buffer;
+        } else {
+          out_ += static_cast<char>(c);
+        }
+      }
     }
-    json result = nodeStack.top();
-    nodeStack.pop();
-    return result;
   }
 
+  std::string &out_;
+  std::vector<Level> stack_;
+  bool pendingValue_ = false;
+};
+
+// ============================================================================
+// AstStreamVisitor - Visitor emitting each node directly to the writer
+// ============================================================================
+// Keys are written in alphabetical order within every object to match the
+// old DOM serializer byte-for-byte.
+
+class AstStreamVisitor : public ASTVisitor {
+public:
+  explicit AstStreamVisitor(StreamingJsonWriter &writer) : writer_(writer) {}
+
   // ========================================================================
   // Expression Visitors
   // ========================================================================
 
   void visit(BinaryExpr &node) override {
-    json j;
-    j["node_type"] = nodeTypeToString(node.getNodeType());
-    addLocation(j, node);
-    j["operator"] = node.getOperator();
-
-    // Visit left operand
-    if (node.getLeft()) {
-      node.getLeft()->accept(*this);
-      j["left"] = getResult();
-    } else {
-      j["left"] = nullptr;
-    }
-
-    // Visit right operand
-    if (node.getRight()) {
-      node.getRight()->accept(*this);
-      j["right"] = getResult();
-    } else {
-      j["right"] = nullptr;
-    }
-
-    nodeStack.push(j);
+    writer_.beginObject();
+    child("left", node.getLeft());
+    location(node);
+    nodeType("BINARY_EXPR");
+    field("operator", node.getOperator());
+    child("right", node.getRight());
+    writer_.endObject();
   }
 
   void visit(UnaryExpr &node) override {
-    json j;
-    j["node_type"] = nodeTypeToString(node.getNodeType());
-    addLocation(j, node);
-    j["operator"] = node.getOperator();
-    j["is_prefix"] = node.isPrefixOp();
-
-    // Visit operand
-    if (node.getOperand()) {
-      node.getOperand()->accept(*this);
-      j["operand"] = getResult();
-    } else {
-      j["operand"] = nullptr;
-    }
-
-    nodeStack.push(j);
+    writer_.beginObject();
+    flag("is_prefix", node.isPrefixOp());
+    location(node);
+    nodeType("UNARY_EXPR");
+    child("operand", node.getOperand());
+    field("operator", node.getOperator());
+    writer_.endObject();
   }
 
   void visit(LiteralExpr &node) override {
-    json j;
-    j["node_type"] = nodeTypeToString(node.getNodeType());
-    addLocation(j, node);
-    j["value"] = node.getValue();
-    j["literal_type"] = literalTypeToString(node.getLiteralType());
-
-    nodeStack.push(j);
+    writer_.beginObject();
+    field("literal_type", literalTypeToString(node.getLiteralType()));
+    location(node);
+    nodeType("LITERAL_EXPR");
+    field("value", node.getValue());
+    writer_.endObject();
   }
 
   void visit(IdentifierExpr &node) override {
-    json j;
-    j["node_type"] = nodeTypeToString(node.getNodeType());
-    addLocation(j, node);
-    j["name"] = node.getName();
-
-    nodeStack.push(j);
+    writer_.beginObject();
+    location(node);
+    field("name", node.getName());
+    nodeType("IDENTIFIER_EXPR");
+    writer_.endObject();
   }
 
   void visit(CallExpr &node) override {
-    json j;
-    j["node_type"] = nodeTypeToString(node.getNodeType());
-    addLocation(j, node);
-
-    // Visit callee
-    if (node.getCallee()) {
-      node.getCallee()->accept(*this);
-      j["callee"] = getResult();
-    } else {
-      j["callee"] = nullptr;
-    }
-
-    // Visit arguments
-    json argsArray = json::array();
-    for (const auto &arg : node.getArguments()) {
+    writer_.beginObject();
+    writer_.key("arguments");
+    writer_.beginArray();
+    for (auto *arg : node.getArguments()) {
       if (arg) {
         arg->accept(*this);
-        argsArray.push_back(getResult());
       }
     }
-    j["arguments"] = argsArray;
-
-    nodeStack.push(j);
+    writer_.endArray();
+    child("callee", node.getCallee());
+    location(node);
+    nodeType("CALL_EXPR");
+    writer_.endObject();
   }
 
   void visit(AssignmentExpr &node) override {
-    json j;
-    j["node_type"] = nodeTypeToString(node.getNodeType());
-    addLocation(j, node);
-
-    // Visit target (LHS)
-    if (node.getTarget()) {
-      node.getTarget()->accept(*this);
-      j["target"] = getResult();
-    } else {
-      j["target"] = nullptr;
-    }
-
-    // Visit value (RHS)
-    if (node.getValue()) {
-      node.getValue()->accept(*this);
-      j["value"] = getResult();
-    } else {
-      j["value"] = nullptr;
-    }
-
-    nodeStack.push(j);
+    writer_.beginObject();
+    location(node);
+    nodeType("ASSIGNMENT_EXPR");
+    child("target", node.getTarget());
+    child("value", node.getValue());
+    writer_.endObject();
   }
 
   void visit(ArrayAccessExpr &node) override {
-    json j;
-    j["node_type"] = nodeTypeToString(node.getNodeType());
-    addLocation(j, node);
-
-    // Visit array
-    if (node.getArray()) {
-      node.getArray()->accept(*this);
-      j["array"] = getResult();
-    } else {
-      j["array"] = nullptr;
-    }
-
-    // Visit index
-    if (node.getIndex()) {
-      node.getIndex()->accept(*this);
-      j["index"] = getResult();
-    } else {
-      j["index"] = nullptr;
-    }
-
-    nodeStack.push(j);
+    writer_.beginObject();
+    child("array", node.getArray());
+    child("index", node.getIndex());
+    location(node);
+    nodeType("ARRAY_ACCESS_EXPR");
+    writer_.endObject();
   }
 
   void visit(MemberAccessExpr &node) override {
-    json j;
-    j["node_type"] = nodeTypeToString(node.getNodeType());
-    addLocation(j, node);
-    j["member_name"] = node.getMemberName();
-    j["is_arrow"] = node.getIsArrow();
-
-    // Visit object
-    if (node.getObject()) {
-      node.getObject()->accept(*this);
-      j["object"] = getResult();
-    } else {
-      j["object"] = nullptr;
-    }
-
-    nodeStack.push(j);
+    writer_.beginObject();
+    flag("is_arrow", node.getIsArrow());
+    location(node);
+    field("member_name", node.getMemberName());
+    nodeType("MEMBER_ACCESS_EXPR");
+    child("object", node.getObject());
+    writer_.endObject();
   }
 
   void visit(TypeCastExpr &node) override {
-    json j;
-    j["node_type"] = nodeTypeToString(node.getNodeType());
-    addLocation(j, node);
-    j["target_type"] = node.getTargetType();
-    j["is_implicit"] = node.getIsImplicit();
-
-    // Visit operand
-    if (node.getOperand()) {
-      node.getOperand()->accept(*this);
-      j["operand"] = getResult();
-    } else {
-      j["operand"] = nullptr;
-    }
-
-    nodeStack.push(j);
+    writer_.beginObject();
+    flag("is_implicit", node.getIsImplicit());
+    location(node);
+    nodeType("TYPE_CAST_EXPR");
+    child("operand", node.getOperand());
+    field("target_type", node.getTargetType());
+    writer_.endObject();
   }
 
   void visit(SizeOfExpr &node) override {
-    json j;
-    j["node_type"] = nodeTypeToString(node.getNodeType());
-    addLocation(j, node);
-    j["target_type"] = node.getTargetType();
-    j["is_type_size"] = node.isTypeSize();
-
-    if (node.getOperand()) {
-      node.getOperand()->accept(*this);
-      j["operand"] = getResult();
-    } else {
-      j["operand"] = nullptr;
-    }
-    nodeStack.push(j);
+    writer_.beginObject();
+    flag("is_type_size", node.isTypeSize());
+    location(node);
+    nodeType("SIZEOF_EXPR");
+    child("operand", node.getOperand());
+    field("target_type", node.getTargetType());
+    writer_.endObject();
   }
 
   void visit(TernaryExpr &node) override {
-    json j;
-    j["node_type"] = nodeTypeToString(node.getNodeType());
-    addLocation(j, node);
-
-    // Condition
-    node.getCondition()->accept(*this);
-    j["condition"] = getResult();
-
-    // True Branch
-    node.getTrueExpr()->accept(*this);
-    j["true_expr"] = getResult();
-
-    // False Branch
-    node.getFalseExpr()->accept(*this);
-    j["false_expr"] = getResult();
-
-    nodeStack.push(j);
+    writer_.beginObject();
+    child("condition", node.getCondition());
+    child("false_expr", node.getFalseExpr());
+    location(node);
+    nodeType("TERNARY_EXPR");
+    child("true_expr", node.getTrueExpr());
+    writer_.endObject();
   }
 
   // ========================================================================
@@ -324,181 +285,86 @@ public:
   // ========================================================================
 
   void visit(IfStmt &node) override {
-    json j;
-    j["node_type"] = nodeTypeToString(node.getNodeType());
-    addLocation(j, node);
-
-    // Visit condition
-    if (node.getCondition()) {
-      node.getCondition()->accept(*this);
-      j["condition"] = getResult();
-    } else {
-      j["condition"] = nullptr;
-    }
-
-    // Visit then branch
-    if (node.getThenBranch()) {
-      node.getThenBranch()->accept(*this);
-      j["then_branch"] = getResult();
-    } else {
-      j["then_branch"] = nullptr;
-    }
-
-    // Visit else branch (optional)
-    if (node.getElseBranch()) {
-      node.getElseBranch()->accept(*this);
-      j["else_branch"] = getResult();
-    } else {
-      j["else_branch"] = nullptr;
-    }
-
-    nodeStack.push(j);
+    writer_.beginObject();
+    child("condition", node.getCondition());
+    child("else_branch", node.getElseBranch());
+    location(node);
+    nodeType("IF_STMT");
+    child("then_branch", node.getThenBranch());
+    writer_.endObject();
   }
 
   void visit(WhileStmt &node) override {
-    json j;
-    j["node_type"] = nodeTypeToString(node.getNodeType());
-    addLocation(j, node);
-
-    // Visit condition
-    if (node.getCondition()) {
-      node.getCondition()->accept(*this);
-      j["condition"] = getResult();
-    } else {
-      j["condition"] = nullptr;
-    }
-
-    // Visit body
-    if (node.getBody()) {
-      node.getBody()->accept(*this);
-      j["body"] = getResult();
-    } else {
-      j["body"] = nullptr;
-    }
-
-    nodeStack.push(j);
+    writer_.beginObject();
+    child("body", node.getBody());
+    child("condition", node.getCondition());
+    location(node);
+    nodeType("WHILE_STMT");
+    writer_.endObject();
   }
 
   void visit(ForStmt &node) override {
-    json j;
-    j["node_type"] = nodeTypeToString(node.getNodeType());
-    addLocation(j, node);
-
-    // Visit initializer (optional)
-    if (node.getInitializer()) {
-      node.getInitializer()->accept(*this);
-      j["initializer"] = getResult();
-    } else {
-      j["initializer"] = nullptr;
-    }
-
-    // Visit condition (optional)
-    if (node.getCondition()) {
-      node.getCondition()->accept(*this);
-      j["condition"] = getResult();
-    } else {
-      j["condition"] = nullptr;
-    }
-
-    // Visit increment (optional)
-    if (node.getIncrement()) {
-      node.getIncrement()->accept(*this);
-      j["increment"] = getResult();
-    } else {
-      j["increment"] = nullptr;
-    }
-
-    // Visit body
-    if (node.getBody()) {
-      node.getBody()->accept(*this);
-      j["body"] = getResult();
-    } else {
-      j["body"] = nullptr;
-    }
-
-    nodeStack.push(j);
+    writer_.beginObject();
+    child("body", node.getBody());
+    child("condition", node.getCondition());
+    child("increment", node.getIncrement());
+    child("initializer", node.getInitializer());
+    location(node);
+    nodeType("FOR_STMT");
+    writer_.endObject();
   }
 
   void visit(ReturnStmt &node) override {
-    json j;
-    j["node_type"] = nodeTypeToString(node.getNodeType());
-    addLocation(j, node);
-
-    // Visit return value (optional for void returns)
-    if (node.getReturnValue()) {
-      node.getReturnValue()->accept(*this);
-      j["return_value"] = getResult();
-    } else {
-      j["return_value"] = nullptr;
-    }
-
-    nodeStack.push(j);
+    writer_.beginObject();
+    location(node);
+    nodeType("RETURN_STMT");
+    child("return_value", node.getReturnValue());
+    writer_.endObject();
   }
 
   void visit(CompoundStmt &node) override {
-    json j;
-    j["node_type"] = nodeTypeToString(node.getNodeType());
-    addLocation(j, node);
-
-    // Visit all statements
-    json stmtsArray = json::array();
-    for (const auto &stmt : node.getStatements()) {
+    writer_.beginObject();
+    location(node);
+    nodeType("COMPOUND_STMT");
+    writer_.key("statements");
+    writer_.beginArray();
+    for (auto *stmt : node.getStatements()) {
       if (stmt) {
         stmt->accept(*this);
-        stmtsArray.push_back(getResult());
       }
     }
-    j["statements"] = stmtsArray;
-
-    nodeStack.push(j);
+    writer_.endArray();
+    writer_.endObject();
   }
 
   void visit(ExpressionStmt &node) override {
-    json j;
-    j["node_type"] = nodeTypeToString(node.getNodeType());
-    addLocation(j, node);
-
-    // Visit expression
-    if (node.getExpression()) {
-      node.getExpression()->accept(*this);
-      j["expression"] = getResult();
-    } else {
-      j["expression"] = nullptr;
-    }
-
-    nodeStack.push(j);
+    writer_.beginObject();
+    child("expression", node.getExpression());
+    location(node);
+    nodeType("EXPRESSION_STMT");
+    writer_.endObject();
   }
 
   void visit(DeclStmt &node) override {
-    json j;
-    j["node_type"] = "DECL_STMT"; // Not in ASTNodeType enum
-    addLocation(j, node);
-
-    // Visit declaration
-    if (node.getDeclaration()) {
-      node.getDeclaration()->accept(*this);
-      j["declaration"] = getResult();
-    } else {
-      j["declaration"] = nullptr;
-    }
-
-    nodeStack.push(j);
+    writer_.beginObject();
+    child("declaration", node.getDeclaration());
+    location(node);
+    nodeType("DECL_STMT"); // Not in ASTNodeType enum
+    writer_.endObject();
   }
 
   void visit(BreakStmt &node) override {
-    json j;
-    j["node_type"] = "BREAK_STMT";
-    addLocation(j, node);
-
-    nodeStack.push(j);
+    writer_.beginObject();
+    location(node);
+    nodeType("BREAK_STMT");
+    writer_.endObject();
   }
 
   void visit(ContinueStmt &node) override {
-    json j;
-    j["node_type"] = "CONTINUE_STMT";
-    addLocation(j, node);
-
-    nodeStack.push(j);
+    writer_.beginObject();
+    location(node);
+    nodeType("CONTINUE_STMT");
+    writer_.endObject();
   }
 
   // ========================================================================
@@ -506,126 +372,154 @@ public:
   // ========================================================================
 
   void visit(VarDecl &node) override {
-    json j;
-    j["node_type"] = nodeTypeToString(node.getNodeType());
-    addLocation(j, node);
-    j["name"] = node.getName();
-    j["type"] = node.getType();
-    j["is_array"] = node.getIsArray();
-    j["pointer_level"] = node.getPointerLevel();
-
-    // Visit initializer (optional)
-    if (node.getInitializer()) {
-      node.getInitializer()->accept(*this);
-      j["initializer"] = getResult();
-    } else {
-      j["initializer"] = nullptr;
-    }
-
-    // Visit array size (optional)
-    if (node.getArraySize()) {
-      node.getArraySize()->accept(*this);
-      j["array_size"] = getResult();
-    } else {
-      j["array_size"] = nullptr;
-    }
-
-    nodeStack.push(j);
+    writer_.beginObject();
+    child("array_size", node.getArraySize());
+    child("initializer", node.getInitializer());
+    flag("is_array", node.getIsArray());
+    location(node);
+    field("name", node.getName());
+    nodeType("VAR_DECL");
+    writer_.key("pointer_level");
+    writer_.writeInt(node.getPointerLevel());
+    field("type", node.getType());
+    writer_.endObject();
   }
 
   void visit(TypeDecl &node) override {
-    json j;
-    j["node_type"] = nodeTypeToString(node.getNodeType());
-    addLocation(j, node);
-    j["name"] = node.getName();
-    j["underlying_type"] = node.getUnderlyingType();
-
-    nodeStack.push(j);
+    writer_.beginObject();
+    location(node);
+    field("name", node.getName());
+    nodeType("TYPE_DECL");
+    field("underlying_type", node.getUnderlyingType());
+    writer_.endObject();
   }
 
   void visit(StructDecl &node) override {
-    json j;
-    j["node_type"] = nodeTypeToString(node.getNodeType());
-    addLocation(j, node);
-    j["name"] = node.getName();
-
-    // Visit all fields
-    json fieldsArray = json::array();
-    for (const auto &field : node.getFields()) {
+    writer_.beginObject();
+    writer_.key("fields");
+    writer_.beginArray();
+    for (auto *field : node.getFields()) {
       if (field) {
         field->accept(*this);
-        fieldsArray.push_back(getResult());
       }
     }
-    j["fields"] = fieldsArray;
-
-    nodeStack.push(j);
+    writer_.endArray();
+    location(node);
+    field("name", node.getName());
+    nodeType("STRUCT_DECL");
+    writer_.endObject();
   }
 
   void visit(FunctionDecl &node) override {
-    json j;
-    j["node_type"] = nodeTypeToString(node.getNodeType());
-    addLocation(j, node);
-    j["name"] = node.getName();
-    j["return_type"] = node.getReturnType();
-
-    // Visit parameters
-    json paramsArray = json::array();
-    for (const auto &param : node.getParameters()) {
+    writer_.beginObject();
+    child("body", node.getBody());
+    location(node);
+    field("name", node.getName());
+    nodeType("FUNCTION_DECL");
+    writer_.key("parameters");
+    writer_.beginArray();
+    for (auto *param : node.getParameters()) {
       if (param) {
         param->accept(*this);
-        paramsArray.push_back(getResult());
       }
     }
-    j["parameters"] = paramsArray;
+    writer_.endArray();
+    field("return_type", node.getReturnType());
+    writer_.endObject();
+  }
 
-    // Visit body (optional for forward declarations)
-    if (node.getBody()) {
-      node.getBody()->accept(*this);
-      j["body"] = getResult();
+  void visit(ParameterDecl &node) override {
+    writer_.beginObject();
+    location(node);
+    field("name", node.getName());
+    nodeType("PARAMETER_DECL");
+    field("type", node.getType());
+    writer_.endObject();
+  }
+
+private:
+  // Field helpers (each writes "key": value at the current level)
+  void nodeType(const char *type) {
+    writer_.key("node_type");
+    writer_.writeString(type);
+  }
+  void field(const char *name, const std::string &value) {
+    writer_.key(name);
+    writer_.writeString(value);
+  }
+  void flag(const char *name, bool value) {
+    writer_.key(name);
+    writer_.writeBool(value);
+  }
+  void child(const char *name, ASTNode *node) {
+    writer_.key(name);
+    if (node != nullptr) {
+      node->accept(*this);
     } else {
-      j["body"] = nullptr;
+      writer_.writeNull();
     }
-
-    nodeStack.push(j);
+  }
+  void location(const ASTNode &node) {
+    writer_.key("location");
+    writer_.beginObject();
+    writer_.key("column");
+    writer_.writeInt(node.getColumn());
+    writer_.key("file");
+    writer_.writeString(node.getLocation().filename);
+    writer_.key("line");
+    writer_.writeInt(node.getLine());
+    writer_.endObject();
   }
 
-  void visit(ParameterDecl &node) override {
-    json j;
-    j["node_type"] = nodeTypeToString(node.getNodeType());
-    addLocation(j, node);
-    j["name"] = node.getName();
-    j["type"] = node.getType();
-
-    nodeStack.push(j);
+  static const char *literalTypeToString(LiteralExpr::LiteralType type) {
+    switch (type) {
+    case LiteralExpr::LiteralType::INTEGER:
+      return "INTEGER";
+    case LiteralExpr::LiteralType::FLOAT:
+      return "FLOAT";
+    case LiteralExpr::LiteralType::STRING:
+      return "STRING";
+    case LiteralExpr::LiteralType::CHAR:
+      return "CHAR";
+    case LiteralExpr::LiteralType::BOOLEAN:
+      return "BOOLEAN";
+    default:
+      return "UNKNOWN";
+    }
   }
+
+  StreamingJsonWriter &writer_;
 };
 
+} // namespace
+
 // ============================================================================
 // Public API Implementation
 // ============================================================================
 
-std::string
-serializeAstToJson(const std::vector<std::unique_ptr<Declaration>> &ast) {
-  json result;
+std::string serializeAstToJson(const std::vector<Declaration *> &ast) {
+  std::string out;
+  // Large trees produce JSON several times their own size; reserving up
+  // front avoids repeated growth copies on big dumps.
+  out.reserve(64 * 1024);
 
-  // Add metadata
-  result["stage"] = "parsing";
-  result["declaration_count"] = ast.size();
-
-  // Serialize all top-level declarations
-  json declArray = json::array();
-  JsonSerializerVisitor visitor;
+  StreamingJsonWriter writer(out);
+  AstStreamVisitor visitor(writer);
 
+  writer.beginObject();
+  writer.key("declaration_count");
+  writer.writeUInt(ast.size());
+  writer.key("declarations");
+  writer.beginArray();
   for (const auto &decl : ast) {
     if (decl) {
       decl->accept(visitor);
-      declArray.push_back(visitor.getResult());
     }
   }
+  writer.endArray();
+  writer.key("stage");
+  writer.writeString("parsing");
+  writer.endObject();
 
-  result["declarations"] = declArray;
-
-  // Convert to string with pretty printing (2-space indentation)
-  return result.dump(2);
+  return out;
 }
@@ -1,87 +1,97 @@
 #include "json_serializers.h"
-#include <fstream>
-#include <iomanip>
+#include "source_buffer.h"
+
 #include <iostream>
-#include <sstream>
+#include <memory>
 
 // ============================================================================
 // Binary Hex Dump Utility Implementation
 // ============================================================================
 
-/**
- * Generate a hexadecimal dump of a binary file
- *
- * Reads the file in chunks and formats each byte as two-digit uppercase hex.
- * Output is formatted with 16 bytes per line, space-separated.
- *
- * Example output:
- *   CF FA ED FE 07 00 00 01 03 00 00 00 02 00 00 00
- *   10 00 00 00 70 04 00 00 85 00 20 00 00 00 00 00
- *   ...
- *
- * @param executablePath Path to the binary executable file
- * @return Formatted hex dump string, or empty string on error
- */
-std::string generateHexDump(const std::string &executablePath) {
-  // Open file in binary mode
-  std::ifstream file(executablePath, std::ios::binary | std::ios::ate);
+namespace {
 
-  // If file open fails, try appending .exe (Windows compatibility)
-  if (!file) {
-    std::string exePath = executablePath + ".exe";
-    file.open(exePath, std::ios::binary | std::ios::ate);
-  }
+constexpr size_t BYTES_PER_LINE = 16;
+const char HEX_DIGITS[] = "0123456789ABCDEF";
 
-  if (!file) {
-    std::cerr << "Error: Could not open file for hex dump: " << executablePath
-              << " (or " << executablePath << ".exe)" << std::endl;
-    return "";
+} // namespace
+
+bool HexDumpView::open(const std::string& path) {
+  buffer_ = std::make_shared<SourceBuffer>();
+  if (!buffer_->loadFile(path)) {
+    // Windows compatibility: retry with .exe appended
+    if (!buffer_->loadFile(path + ".exe")) {
+      std::cerr << "Error: Could not open file for hex dump: " << path
+                << " (or " << path << ".exe)" << std::endl;
+      buffer_.reset();
+      return false;
+    }
+  }
+  if (buffer_->size() == 0) {
+    std::cerr << "Warning: File is empty: " << path << std::endl;
+    buffer_.reset();
+    return false;
   }
+  return true;
+}
 
-  // Get file size
-  std::streamsize fileSize = file.tellg();
-  file.seekg(0, std::ios::beg);
+size_t HexDumpView::size() const {
+  return buffer_ ? buffer_->size() : 0;
+}
 
-  if (fileSize == 0) {
-    std::cerr << "Warning: File is empty: " << executablePath << std::endl;
+std::string HexDumpView::formatRange(size_t offset, size_t length) const {
+  if (!buffer_) {
+    return "";
+  }
+  const std::string_view data = buffer_->view();
+  if (offset >= data.size()) {
     return "";
   }
 
-  std::ostringstream hexOutput;
-  hexOutput << std::hex << std::uppercase << std::setfill('0');
-
-  const int BYTES_PER_LINE = 16;
-  int bytesInCurrentLine = 0;
+  // Align to line boundaries and clamp to the file
+  size_t begin = (offset / BYTES_PER_LINE) * BYTES_PER_LINE;
+  size_t end = offset + length;
+  if (end > data.size() || end < offset) {
+    end = data.size();
+  }
 
-  // Read file byte by byte
-  char byte;
-  while (file.get(byte)) {
-    // Convert byte to unsigned to avoid sign extension issues
-    unsigned char ubyte = static_cast<unsigned char>(byte);
+  // Each byte costs 3 output chars ("XX " or "XX\n"); reserve exactly
+  std::string out;
+  out.reserve((end - begin) * 3 + BYTES_PER_LINE);
 
-    // Add space before byte (except at start of line)
-    if (bytesInCurrentLine > 0) {
-      hexOutput << ' ';
+  size_t column = 0;
+  for (size_t i = begin; i < end; ++i) {
+    unsigned char byte = static_cast<unsigned char>(data[i]);
+    if (column > 0) {
+      out += ' ';
     }
-
-    // Write byte as two-digit hex
-    hexOutput << std::setw(2) << static_cast<int>(ubyte);
-
-    bytesInCurrentLine++;
-
-    // Start new line after 16 bytes
-    if (bytesInCurrentLine == BYTES_PER_LINE) {
-      hexOutput << '\n';
-      bytesInCurrentLine = 0;
+    out += HEX_DIGITS[byte >> 4];
+    out += HEX_DIGITS[byte & 0xF];
+    if (++column == BYTES_PER_LINE) {
+      out += '\n';
+      column = 0;
     }
   }
-
-  // Add final newline if last line wasn't complete
-  if (bytesInCurrentLine > 0) {
-    hexOutput << '\n';
+  if (column > 0) {
+    out += '\n';
   }
+  return out;
+}
 
-  file.close();
-
-  return hexOutput.str();
+/**
+ * Generate a hexadecimal dump of a binary file
+ *
+ * Now a whole-file window over HexDumpView: the file is memory-mapped and
+ * formatted with a digit table instead of being read byte-by-byte through
+ * an ostringstream. Output format is unchanged (16 space-separated
+ * uppercase hex bytes per line).
+ *
+ * @param executablePath Path to the binary executable file
+ * @return Formatted hex dump string, or empty string on error
+ */
+std::string generateHexDump(const std::string &executablePath) {
+  HexDumpView view;
+  if (!view.open(executablePath)) {
+    return "";
+  }
+  return view.formatRange(0, view.size());
 }
@@ -50,6 +50,114 @@ static json tokenToJson(const Token& token) {
  * @param tokens Vector of Token objects from lexer
  * @return JSON string representation
  */
+// ============================================================================
+// Binary Token Stream Format ("MTK1")
+// ============================================================================
+// Compact fixed-width alternative to the JSON dump, selectable via
+// Options::dumpTokensBinPath. Layout (all integers little-endian u32):
+//
+//   magic "MTK1"
+//   token_count
+//   type_name_count
+//   string_table_size
+//   type_name_count x { name_offset, name_length }   (indexed by type enum)
+//   token_count x { type, value_offset, value_length,
+//                   processed_offset, processed_length,   (0,0 = same)
+//                   file_offset, file_length, line, column }
+//   string table bytes
+//
+// Lexemes, filenames and type names are interned into one string table,
+// so repeated identifiers cost 8 bytes per occurrence instead of a quoted
+// JSON copy. Decoder lives in api/utils/token_stream.py.
+
+namespace {
+
+class BinaryStringTable {
+public:
+    // Intern `text`, returning {offset, length} into the table
+    std::pair<uint32_t, uint32_t> intern(const std::string& text) {
+        auto it = offsets_.find(text);
+        if (it != offsets_.end()) {
+            return {it->second, static_cast<uint32_t>(text.size())};
+        }
+        uint32_t offset = static_cast<uint32_t>(data_.size());
+        data_ += text;
+        offsets_.emplace(text, offset);
+        return {offset, static_cast<uint32_t>(text.size())};
+    }
+
+    const std::string& data() const { return data_; }
+
+private:
+    std::string data_;
+    std::unordered_map<std::string, uint32_t> offsets_;
+};
+
+inline void appendU32(std::string& out, uint32_t value) {
+    out.push_back(static_cast<char>(value));
+    out.push_back(static_cast<char>(value >> 8));
+    out.push_back(static_cast<char>(value >> 16));
+    out.push_back(static_cast<char>(value >> 24));
+}
+
+} // namespace
+
+std::string serializeTokensToBinary(const std::vector<Token>& tokens) {
+    const uint32_t typeNameCount =
+        static_cast<uint32_t>(TokenType::UNKNOWN) + 1;
+
+    BinaryStringTable strings;
+
+    // Type-name table (indexed by the enum value in each record)
+    std::string typeNameSection;
+    for (uint32_t t = 0; t < typeNameCount; ++t) {
+        auto entry =
+            strings.intern(token_type_to_string(static_cast<TokenType>(t)));
+        appendU32(typeNameSection, entry.first);
+        appendU32(typeNameSection, entry.second);
+    }
+
+    // Token records (EOF excluded, mirroring the JSON dump)
+    std::string records;
+    uint32_t tokenCount = 0;
+    for (const auto& token : tokens) {
+        if (token.type == TokenType::EOF_TOKEN) {
+            continue;
+        }
+        tokenCount++;
+
+        auto value = strings.intern(std::string(token.value));
+        std::pair<uint32_t, uint32_t> processed{0, 0};
+        if (!token.processed_value.empty() &&
+            token.processed_value != token.value) {
+            processed = strings.intern(token.processed_value);
+        }
+        auto file = strings.intern(token.filename);
+
+        appendU32(records, static_cast<uint32_t>(token.type));
+        appendU32(records, value.first);
+        appendU32(records, value.second);
+        appendU32(records, processed.first);
+        appendU32(records, processed.second);
+        appendU32(records, file.first);
+        appendU32(records, file.second);
+        appendU32(records, static_cast<uint32_t>(token.line));
+        appendU32(records, static_cast<uint32_t>(token.column));
+    }
+
+    std::string out;
+    out.reserve(16 + typeNameSection.size() + records.size() +
+                strings.data().size());
+    out += "MTK1";
+    appendU32(out, tokenCount);
+    appendU32(out, typeNameCount);
+    appendU32(out, static_cast<uint32_t>(strings.data().size()));
+    out += typeNameSection;
+    out += records;
+    out += strings.data();
+    return out;
+}
+
 std::string serializeTokensToJson(const std::vector<Token>& tokens) {
     json result;
 